@@ -0,0 +1,51 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+/*
+ * QEMU RISC-V Virt Board Memory Map
+ *
+ * Single source for the memory map and flash geometry: platform.h (C and
+ * assembly) includes it, and the Makefile runs linker/memory.ld and
+ * linker/test_app.ld through the preprocessor with it, so the linker
+ * MEMORY regions always match the constants the flash code checks against.
+ *
+ * Plain integer expressions only (no suffixes or casts): the linker reads
+ * them too. Sizes must be powers of two where include/boot.h says so.
+ */
+
+/* Bootloader flash area (FLASH is simulated at the start of RAM on QEMU);
+ * the boot state record takes its last sector */
+#define FLASH_BASE          0x80000000
+#define FLASH_SIZE          (64 * 1024)
+#define STATE_SIZE          (4 * 1024)
+#define STATE_BASE          (FLASH_BASE + FLASH_SIZE - STATE_SIZE)
+
+/* Application partition, right after the bootloader area. make APP_MB=<n>
+ * sizes it for multi-megabyte images; RAM then moves up above it */
+#define APP_BASE            (FLASH_BASE + FLASH_SIZE)
+#ifdef APP_PARTITION_MB
+#define APP_MAX_SIZE        (APP_PARTITION_MB * 1024 * 1024)
+#else
+#define APP_MAX_SIZE        (448 * 1024)
+#endif
+
+/* Flash geometry */
+#define FLASH_SECTOR_SIZE   (4 * 1024)      /* Erase granularity */
+#define FLASH_PAGE_SIZE     256             /* Program granularity */
+
+/* RAM: .data/.bss/stacks, with the scratch arena at the top */
+#ifdef APP_PARTITION_MB
+#define RAM_BASE            (APP_BASE + APP_MAX_SIZE)
+#else
+#define RAM_BASE            0x80100000
+#endif
+#define RAM_SIZE            (128 * 1024)
+#define ARENA_SIZE          (32 * 1024)
+#define WORKER_STACK_SIZE   (2 * 1024)
+
+/* Bootloader .data/.bss/worker stack, at the bottom of RAM. They stay live
+ * while a deferred image check runs next to the app (FW_FLAG_DEFERRED), so
+ * apps keep to the RAM above; the main stack and arena are free by then */
+#define BOOT_RAM_SIZE       (32 * 1024)
+
+#endif /* BOARD_H */
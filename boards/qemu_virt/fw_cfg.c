@@ -0,0 +1,153 @@
+#include "boot.h"
+
+/*
+ * QEMU Firmware Configuration (fw_cfg) Host Image Source
+ *
+ * Implements the platform_hostimg_* HAL: the host hands a firmware blob to
+ * the bootloader without any UART transfer, e.g.
+ *   -fw_cfg name=opt/rvbl/app,file=app.img
+ *
+ * Data is moved with the fw_cfg DMA interface (one MMIO write per chunk).
+ * All fw_cfg DMA structures and the directory are big-endian.
+ *
+ * PORTING NOTES:
+ * - Real boards have no fw_cfg; platform_hostimg_open() simply returns 0
+ */
+
+#define FW_CFG_BASE         0x10100000
+#define FW_CFG_DATA         0x00
+#define FW_CFG_SELECTOR     0x08
+#define FW_CFG_DMA_HI       0x10
+#define FW_CFG_DMA_LO       0x14    /* writing the low half starts the DMA */
+
+#define FW_CFG_SIGNATURE    0x0000
+#define FW_CFG_ID           0x0001
+#define FW_CFG_FILE_DIR     0x0019
+
+#define FW_CFG_ID_DMA       0x02
+
+#define FW_CFG_DMA_ERROR    0x01
+#define FW_CFG_DMA_READ     0x02
+#define FW_CFG_DMA_SKIP     0x04
+#define FW_CFG_DMA_SELECT   0x08
+
+#define FW_CFG_NAME_LEN     56
+#define FW_CFG_APP_NAME     "opt/rvbl/app"
+
+typedef struct {
+    uint32_t control;
+    uint32_t length;
+    uint32_t address_hi;
+    uint32_t address_lo;
+} fw_cfg_dma_t;
+
+typedef struct {
+    uint32_t size;
+    uint16_t select;
+    uint16_t reserved;
+    char name[FW_CFG_NAME_LEN];
+} fw_cfg_file_t;
+
+static volatile fw_cfg_dma_t fw_cfg_dma __attribute__((aligned(16)));
+static uint16_t app_select;
+
+static inline uint32_t be32(uint32_t v) {
+    return bswap32(v);
+}
+
+static inline uint16_t be16(uint16_t v) {
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+static inline volatile uint8_t *fw_cfg_reg8(uint32_t off) {
+    return (volatile uint8_t *)(uintptr_t)(FW_CFG_BASE + off);
+}
+
+static inline volatile uint32_t *fw_cfg_reg32(uint32_t off) {
+    return (volatile uint32_t *)(uintptr_t)(FW_CFG_BASE + off);
+}
+
+/* Legacy byte-wise access, used only to probe for the DMA interface */
+static uint32_t fw_cfg_read_le32(uint16_t key) {
+    *(volatile uint16_t *)(uintptr_t)(FW_CFG_BASE + FW_CFG_SELECTOR) = be16(key);
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v |= (uint32_t)*fw_cfg_reg8(FW_CFG_DATA) << (8 * i);
+    }
+    return v;
+}
+
+/* Run one DMA command; @key is only used when SELECT is in @control */
+static int fw_cfg_dma_run(uint32_t control, uint16_t key, void *buf, uint32_t len) {
+    fw_cfg_dma.control = be32(((uint32_t)key << 16) | control);
+    fw_cfg_dma.length = be32(len);
+    fw_cfg_dma.address_hi = be32((uint32_t)((uint64_t)(uintptr_t)buf >> 32));
+    fw_cfg_dma.address_lo = be32((uint32_t)(uintptr_t)buf);
+
+    __asm__ volatile ("fence iorw, iorw" ::: "memory");
+    *fw_cfg_reg32(FW_CFG_DMA_HI) = be32((uint32_t)((uint64_t)(uintptr_t)&fw_cfg_dma >> 32));
+    *fw_cfg_reg32(FW_CFG_DMA_LO) = be32((uint32_t)(uintptr_t)&fw_cfg_dma);
+
+    /* QEMU completes synchronously; poll anyway as the spec requires */
+    uint32_t ctl;
+    do {
+        __asm__ volatile ("fence iorw, iorw" ::: "memory");
+        ctl = be32(fw_cfg_dma.control);
+    } while (ctl & ~FW_CFG_DMA_ERROR);
+
+    return (ctl & FW_CFG_DMA_ERROR) ? -1 : 0;
+}
+
+static int name_matches(const char *name, const char *want) {
+    for (int i = 0; i < FW_CFG_NAME_LEN; i++) {
+        if (name[i] != want[i]) {
+            return 0;
+        }
+        if (want[i] == '\0') {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint32_t platform_hostimg_open(void) {
+    app_select = 0;
+
+    /* "QEMU" signature, then require the DMA interface */
+    if (fw_cfg_read_le32(FW_CFG_SIGNATURE) != 0x554D4551U) {
+        return 0;
+    }
+    if (!(fw_cfg_read_le32(FW_CFG_ID) & FW_CFG_ID_DMA)) {
+        return 0;
+    }
+
+    /* Walk the file directory looking for our entry */
+    uint32_t count;
+    if (fw_cfg_dma_run(FW_CFG_DMA_SELECT | FW_CFG_DMA_READ, FW_CFG_FILE_DIR, &count, 4) != 0) {
+        return 0;
+    }
+    count = be32(count);
+
+    fw_cfg_file_t file;
+    for (uint32_t i = 0; i < count; i++) {
+        if (fw_cfg_dma_run(FW_CFG_DMA_READ, 0, &file, sizeof(file)) != 0) {
+            return 0;
+        }
+        if (name_matches(file.name, FW_CFG_APP_NAME)) {
+            app_select = be16(file.select);
+            return be32(file.size);
+        }
+    }
+    return 0;
+}
+
+int platform_hostimg_read(uint32_t offset, void *buf, size_t len) {
+    if (app_select == 0) {
+        return -1;
+    }
+    /* Re-select (resets the item offset), skip forward, then read */
+    if (fw_cfg_dma_run(FW_CFG_DMA_SELECT | FW_CFG_DMA_SKIP, app_select, NULL, offset) != 0) {
+        return -1;
+    }
+    return fw_cfg_dma_run(FW_CFG_DMA_READ, 0, buf, (uint32_t)len);
+}
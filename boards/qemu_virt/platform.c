@@ -1,33 +1,50 @@
 #include "boot.h"
+#include "virtio.h"
 
 /* 
  * QEMU Virt Platform Implementation
  * 
  * Hardware: QEMU RISC-V 'virt' machine
- * UART: 16550A compatible at 0x10000000
+ * UART: 16550A compatible at 0x10000000 (or wherever the DTB puts it)
  *
  * PORTING NOTES:
  * - Real hardware will need clock/PLL init in platform_early_init()
- * - Flash operations here are simplified (direct RAM access)
+ * - Flash operations here are simplified (RAM-backed, with a timing model)
  * - Real flash needs: sector erase, page write, status polling, write enable
  * - Consider adding watchdog disable in early_init for long operations
  */
 
-#define UART0_BASE 0x10000000
+/* UART0_BASE (platform.h) unless the device tree says otherwise */
+static uintptr_t uart_base = UART0_BASE;
 
 /* Use explicit volatile cast to prevent compiler optimizations on register polling */
-#define UART_REG(r) (*(volatile uint8_t *)(UART0_BASE + (r)))
+#define UART_REG(r) (*(volatile uint8_t *)(uart_base + (r)))
 
 #define UART_THR 0
 #define UART_RBR 0
 #define UART_IER 1
 #define UART_FCR 2
 #define UART_LCR 3
+#define UART_MCR 4
 #define UART_LSR 5
 
+#define UART_MCR_DTR      0x01
+#define UART_MCR_RTS      0x02
 #define UART_LSR_RX_READY 0x01
+#define UART_LSR_OVERRUN  0x02
 #define UART_LSR_TX_IDLE  0x20
 
+static uint32_t uart_overruns;
+
+/* Line status read; OE clears on read, so every read accounts for it */
+static RAMFUNC uint8_t uart_lsr(void) {
+    uint8_t lsr = UART_REG(UART_LSR);
+    if (lsr & UART_LSR_OVERRUN) {
+        uart_overruns++;
+    }
+    return lsr;
+}
+
 /* =============================================================================
  * Platform Initialization
  * ============================================================================= */
@@ -46,6 +63,16 @@ void platform_early_init(void) {
      */
 }
 
+void platform_discover(const fdt_info_t *fdt) {
+    if (fdt->uart_base) {
+        uart_base = fdt->uart_base;
+    }
+    /* QEMU lists one node per virtio-mmio slot, populated or not */
+    if (fdt->virtio_count) {
+        virtio_set_slots(fdt->virtio_base, fdt->virtio_count);
+    }
+}
+
 /* =============================================================================
  * UART Implementation
  * ============================================================================= */
@@ -63,76 +90,161 @@ void platform_uart_init(void) {
     UART_REG(UART_IER) = 0x00; /* Disable interrupts */
     UART_REG(UART_LCR) = 0x03; /* 8N1 */
     UART_REG(UART_FCR) = 0x07; /* Enable FIFO, clear TX/RX */
+    UART_REG(UART_MCR) = UART_MCR_DTR | UART_MCR_RTS; /* Ready to receive */
 }
 
-void platform_uart_putc(char c) {
+RAMFUNC void platform_uart_putc(char c) {
     /* Wait for TX to be idle before writing a character */
-    while (!(UART_REG(UART_LSR) & UART_LSR_TX_IDLE));
+    while (!(uart_lsr() & UART_LSR_TX_IDLE));
     UART_REG(UART_THR) = (uint8_t)c;
 }
 
-char platform_uart_getc(void) {
+RAMFUNC char platform_uart_getc(void) {
     /* Blocking read: wait until RX data available then return it */
-    while (!(UART_REG(UART_LSR) & UART_LSR_RX_READY));
+    while (!(uart_lsr() & UART_LSR_RX_READY));
     return (char)UART_REG(UART_RBR);
 }
 
+RAMFUNC int platform_uart_rx_ready(void) {
+    return (uart_lsr() & UART_LSR_RX_READY) != 0;
+}
+
+RAMFUNC void platform_uart_set_rts(int on) {
+    UART_REG(UART_MCR) = UART_MCR_DTR | (on ? UART_MCR_RTS : 0);
+}
+
+uint32_t platform_uart_overruns(void) {
+    return uart_overruns;
+}
+
 /* =============================================================================
  * Flash Implementation
  * ============================================================================= */
 
-int platform_flash_write(uint32_t addr, const void *data, size_t size) {
-    /*
-     * QEMU: Direct memory write (RAM-backed)
-     *
-     * For real SPI/embedded flash:
-     * 1. Send write enable command
-     * 2. Wait for flash ready (WIP bit)
-     * 3. Write data in page-aligned chunks (typically 256 bytes)
-     * 4. Poll status register until write completes
-     * 5. Verify if critical
-     *
-     * Requirements:
-     * - addr must be aligned to flash page size
-     * - size should be multiple of page size (or handle partial pages)
-     * - Target must be erased first (all 0xFF)
-     * - May need to disable interrupts during write
-     */
-    uint8_t *dest = (uint8_t *)(uintptr_t)addr;
-    const uint8_t *src = (const uint8_t *)data;
-    for (size_t i = 0; i < size; i++) {
-        /* Per-byte write; QEMU allows direct memory writes. Real flash needs
-         * page-oriented logic and status checks. */
-        dest[i] = src[i];
+/*
+ * QEMU flash is RAM-backed, so the model adds the time real flash takes:
+ * an operation completes PLATFORM_FLASH_PAGE_CYCLES per page programmed or
+ * PLATFORM_FLASH_SECTOR_CYCLES per sector erased after submit (mcycle),
+ * and its effect lands in memory at completion. Callers that block on it
+ * see realistic stalls; callers that poll see how much work they overlap.
+ *
+ * For real SPI/embedded flash, submit issues the command and poll reads the
+ * controller's busy/WIP status:
+ * - write: write enable, program page by page (typically 256 bytes), each
+ *   page waiting for WIP to clear; optionally verify
+ * - erase: write enable, sector/block erase (ms to seconds per sector);
+ *   typical sector sizes are 4KB (uniform) or mixed (4KB + 32KB + 64KB)
+ * - Consider feeding the watchdog while polling large erases
+ */
+static struct {
+    int busy;
+    int op;
+    uintptr_t addr;
+    const void *data;
+    size_t size;
+    uint32_t start;     /* mcycle at submit */
+    uint32_t cycles;    /* Modeled duration */
+    flash_done_fn done;
+    void *ctx;
+} flash_op;
+
+RAMFUNC int platform_flash_submit(int op, uintptr_t addr, const void *data, size_t size,
+                          flash_done_fn done, void *ctx) {
+    if (flash_op.busy || (op != FLASH_OP_WRITE && op != FLASH_OP_ERASE)) {
+        return -1;
+    }
+    if (op == FLASH_OP_ERASE) {
+        flash_op.cycles = (uint32_t)(size / FLASH_SECTOR_SIZE) * PLATFORM_FLASH_SECTOR_CYCLES;
+    } else {
+        flash_op.cycles = (uint32_t)((size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) *
+                          PLATFORM_FLASH_PAGE_CYCLES;
     }
+    flash_op.op = op;
+    flash_op.addr = addr;
+    flash_op.data = data;
+    flash_op.size = size;
+    flash_op.done = done;
+    flash_op.ctx = ctx;
+    flash_op.start = cycle_count();
+    flash_op.busy = 1;
     return 0;
 }
 
-int platform_flash_erase(uint32_t addr, size_t size) {
-    /*
-     * QEMU: Fill with 0xFF (simulated erase)
-     *
-     * For real SPI/embedded flash:
-     * 1. Send write enable command
-     * 2. Send sector/block erase command
-     * 3. Wait for erase complete (can take ms to seconds)
-     * 4. Repeat for each sector in range
-     *
-     * Requirements:
-     * - addr must be sector-aligned (typical: 4KB sectors)
-     * - size must be multiple of sector size
-     * - May need to disable watchdog for large erases
-     * - Consider feeding watchdog between sectors
-     *
-     * Typical sector sizes: 4KB (uniform) or mixed (4KB + 32KB + 64KB)
-     */
-    uint8_t *dest = (uint8_t *)(uintptr_t)addr;
-    for (size_t i = 0; i < size; i++) {
-        dest[i] = 0xFF; /* Simulated erase value */
+RAMFUNC int platform_flash_poll(void) {
+    if (!flash_op.busy) {
+        return 0;
+    }
+    if (cycle_count() - flash_op.start < flash_op.cycles) {
+        return 1;
+    }
+
+    /* Complete: word-wide (or RVV) copy/fill of the RAM-backed array
+     * (memcpy/memset are RAMFUNC too) */
+    if (flash_op.op == FLASH_OP_ERASE) {
+        memset((void *)flash_op.addr, 0xFF, flash_op.size);
+    } else {
+        memcpy((void *)flash_op.addr, flash_op.data, flash_op.size);
+    }
+
+    /* Idle before the callback, so it can submit the next operation */
+    flash_op.busy = 0;
+    if (flash_op.done) {
+        flash_op.done(0, flash_op.ctx);
     }
     return 0;
 }
 
+/* =============================================================================
+ * Update Decryption Key
+ * ============================================================================= */
+
+/*
+ * QEMU: published development key (keys/dev_aes256.key on the host side).
+ *
+ * For real hardware:
+ * - Read the key from OTP/eFuse or a key slot of the crypto block
+ * - Lock the slot against software readout once the bootloader is done
+ */
+static const uint8_t update_key[32] = {
+    0xb9, 0xac, 0xf8, 0x5e, 0xda, 0x0a, 0xbf, 0xd0,
+    0x6b, 0x16, 0x2f, 0x8c, 0xbc, 0xc4, 0x7c, 0x74,
+    0x8f, 0x1a, 0x1d, 0xac, 0x4b, 0xa5, 0x4a, 0x38,
+    0x70, 0x8d, 0xb1, 0x02, 0x72, 0x88, 0x66, 0x8f,
+};
+
+size_t platform_update_key(const uint8_t **key) {
+    *key = update_key;
+    return sizeof(update_key);
+}
+
+/* =============================================================================
+ * Hart Control (CLINT software interrupts)
+ * ============================================================================= */
+
+#define CLINT_MSIP(hart)    ((volatile uint32_t *)(uintptr_t)(CLINT_BASE + 4 * (hart)))
+
+void platform_hart_start(unsigned hart) {
+    /* Memory writes so far are ordered before the MMIO wake-up */
+    __asm__ volatile ("fence rw, o" ::: "memory");
+    *CLINT_MSIP(hart) = 1;
+}
+
+void platform_hart_wait_start(void) {
+    uintptr_t hart;
+    __asm__ volatile ("csrr %0, mhartid" : "=r"(hart));
+
+    /* MSIE lets the IPI end wfi; mstatus.MIE stays clear, so nothing traps */
+    __asm__ volatile ("csrs mie, %0" :: "r"(1u << 3));
+    while ((*CLINT_MSIP(hart) & 1) == 0) {
+        __asm__ volatile ("wfi");
+    }
+    *CLINT_MSIP(hart) = 0;
+    __asm__ volatile ("csrc mie, %0" :: "r"(1u << 3));
+
+    /* Later memory reads see what the releasing hart wrote */
+    __asm__ volatile ("fence i, rw" ::: "memory");
+}
+
 /* =============================================================================
  * System Control
  * ============================================================================= */
@@ -8,21 +8,68 @@
  * When porting to real hardware, create a new board directory with its own platform.h
  */
 
-/* Memory Map - Adjust for your target hardware */
-/* NOTE: These addresses reflect the QEMU virt memory map used for testing. */
-#define FLASH_BASE          0x80000000
-#define APP_BASE            0x80010000
-#define FLASH_SIZE          (64 * 1024)
-#define APP_MAX_SIZE        (448 * 1024)
+/* Memory map and flash geometry (shared with the linker scripts) */
+#include "board.h"
+
+/* Flash timing model (RAM-backed QEMU flash, see platform_flash_submit()):
+ * mcycle ticks per page program / sector erase. Small values keep the demo
+ * fast; raise them to rehearse slow parts. */
+#define PLATFORM_FLASH_PAGE_CYCLES   2000
+#define PLATFORM_FLASH_SECTOR_CYCLES 50000
+
+/* Device tree: QEMU passes a DTB in a1; RAM size, hart count, UART and
+ * virtio addresses are read from it at boot (src/fdt.c). The values here
+ * are the fallback. 0 = never look at a1 (boards without a DTB). */
+#define PLATFORM_FDT        1
 
 /* UART Configuration */
 #define UART0_BASE          0x10000000
 #define UART_BAUDRATE       115200
 
+/* UART flow control: the 16550 RTS line for hosts/adapters with hardware
+ * handshake, and optionally XON/XOFF in-band. XON/XOFF puts 0x11/0x13 bytes
+ * into the output stream, which only a host that strips them (such as
+ * test_validator.py) can tolerate, so it is opt-in. Either may be 0. QEMU
+ * paces stdio input by the 16550 FIFO, so the demo needs neither. */
+#define PLATFORM_UART_XONXOFF 0
+#define PLATFORM_UART_RTSCTS  1
+
+/* Core-local interruptor (software interrupts wake parked harts) */
+#define CLINT_BASE          0x02000000
+
+/* Update worker: this hart (if present) decrypts, checksums and programs
+ * chunks while hart 0 receives. Hart 0 gives up waiting for it after
+ * PLATFORM_WORKER_START_TIMEOUT cycles and works alone (QEMU -smp 1). */
+#define PLATFORM_WORKER_HART 1
+#define PLATFORM_WORKER_START_TIMEOUT 5000000
+
 /* Platform Identification */
+#if __riscv_xlen == 64
+#define PLATFORM_NAME       "QEMU Virt (RV64IMAC)"
+#else
 #define PLATFORM_NAME       "QEMU Virt (RV32IM)"
+#endif
+
+/* BOOT? window: boot the installed app if no key arrives within this many
+ * mcycle ticks (0 = wait for a key forever, as the QEMU demo expects) */
+#define PLATFORM_BOOT_TIMEOUT_CYCLES 0
+
+/* Deferred verification: images flagged FW_FLAG_DEFERRED start before the
+ * payload check ends, which the worker hart finishes (needs QEMU -smp 2).
+ * 0 = always check in full before the handoff. */
+#define PLATFORM_DEFERRED_VERIFY 1
 
 /* Demo UX: run application directly after successful update in QEMU. */
 #define PLATFORM_DIRECT_BOOT_AFTER_UPDATE 1
 
+/* Development boots: load the app from the host via semihosting if offered
+ * (QEMU -semihosting). Harmless without a host; set to 0 on boards where a
+ * debugger may intercept ebreak. */
+#define PLATFORM_SEMIHOSTING 1
+#define PLATFORM_SEMIHOSTING_IMAGE "test_app.bin"
+
+/* Secure boot policy: 1 = refuse images without a valid Ed25519 signature.
+ * Signed images are always verified; 0 keeps unsigned UART uploads bootable. */
+#define PLATFORM_REQUIRE_SIGNATURE 0
+
 #endif /* PLATFORM_H */
@@ -0,0 +1,148 @@
+#include "boot.h"
+#include "virtio.h"
+
+/*
+ * Minimal polled virtio-mmio transport (QEMU virt board)
+ *
+ * Only what the bootloader's image sources need: device discovery, feature
+ * negotiation, queue registration and synchronous descriptor chains.
+ */
+
+/* Order ring updates against the device (RAM and MMIO) */
+static inline void virtio_mb(void) {
+    __asm__ volatile ("fence iorw, iorw" ::: "memory");
+}
+
+/* Slots from the device tree; empty = the fixed QEMU virt layout */
+static uintptr_t slot_base[FDT_MAX_VIRTIO];
+static uint32_t slot_count;
+
+void virtio_set_slots(const uintptr_t *base, uint32_t count) {
+    if (count > FDT_MAX_VIRTIO) {
+        count = FDT_MAX_VIRTIO;
+    }
+    memcpy(slot_base, base, count * sizeof(base[0]));
+    slot_count = count;
+}
+
+uintptr_t virtio_find(uint32_t device_id) {
+    uint32_t slots = slot_count ? slot_count : VIRTIO_MMIO_SLOTS;
+    for (uint32_t slot = 0; slot < slots; slot++) {
+        uintptr_t base = slot_count ? slot_base[slot]
+                                    : VIRTIO_MMIO_BASE + slot * VIRTIO_MMIO_STRIDE;
+        if (*virtio_reg(base, VIRTIO_MMIO_MAGIC) != VIRTIO_MMIO_MAGIC_VALUE) {
+            continue;
+        }
+        /* Device ID 0 marks an empty slot */
+        if (*virtio_reg(base, VIRTIO_MMIO_DEVICE_ID) == device_id) {
+            return base;
+        }
+    }
+    return 0;
+}
+
+int virtio_setup(uintptr_t base, uint32_t features) {
+    uint32_t version = *virtio_reg(base, VIRTIO_MMIO_VERSION);
+
+    /* Reset, then announce ourselves */
+    *virtio_reg(base, VIRTIO_MMIO_STATUS) = 0;
+    *virtio_reg(base, VIRTIO_MMIO_STATUS) = VIRTIO_STATUS_ACK;
+    *virtio_reg(base, VIRTIO_MMIO_STATUS) = VIRTIO_STATUS_ACK | VIRTIO_STATUS_DRIVER;
+
+    /* Accept only the requested low feature bits */
+    *virtio_reg(base, VIRTIO_MMIO_DEV_FEATURES_SEL) = 0;
+    uint32_t offered = *virtio_reg(base, VIRTIO_MMIO_DEV_FEATURES);
+    *virtio_reg(base, VIRTIO_MMIO_DRV_FEATURES_SEL) = 0;
+    *virtio_reg(base, VIRTIO_MMIO_DRV_FEATURES) = offered & features;
+
+    if (version == 1) {
+        /* Legacy: queue addresses are given as page frame numbers */
+        *virtio_reg(base, VIRTIO_MMIO_GUEST_PAGE_SIZE) = VIRTQ_LEGACY_PAGE;
+        return 0;
+    }
+
+    /* Modern: VIRTIO_F_VERSION_1 (feature bit 32) is mandatory */
+    *virtio_reg(base, VIRTIO_MMIO_DRV_FEATURES_SEL) = 1;
+    *virtio_reg(base, VIRTIO_MMIO_DRV_FEATURES) = 1;
+    *virtio_reg(base, VIRTIO_MMIO_STATUS) = VIRTIO_STATUS_ACK | VIRTIO_STATUS_DRIVER |
+                                            VIRTIO_STATUS_FEATURES_OK;
+    if (!(*virtio_reg(base, VIRTIO_MMIO_STATUS) & VIRTIO_STATUS_FEATURES_OK)) {
+        *virtio_reg(base, VIRTIO_MMIO_STATUS) = VIRTIO_STATUS_FAILED;
+        return -1;
+    }
+    return 0;
+}
+
+int virtio_queue_init(uintptr_t base, uint32_t index, virtq_t *vq) {
+    /* Start from a clean ring (the device may have been used before) */
+    memset(vq, 0, sizeof(*vq));
+    vq->base = base;
+    vq->index = index;
+
+    *virtio_reg(base, VIRTIO_MMIO_QUEUE_SEL) = index;
+    if (*virtio_reg(base, VIRTIO_MMIO_QUEUE_NUM_MAX) < VIRTQ_SIZE) {
+        return -1;
+    }
+    *virtio_reg(base, VIRTIO_MMIO_QUEUE_NUM) = VIRTQ_SIZE;
+
+    uintptr_t addr = (uintptr_t)vq;
+    if (*virtio_reg(base, VIRTIO_MMIO_VERSION) == 1) {
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_ALIGN) = VIRTQ_LEGACY_ALIGN;
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_PFN) = (uint32_t)(addr / VIRTQ_LEGACY_PAGE);
+    } else {
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_DESC_LO) = virtio_addr_lo(&vq->desc[0]);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_DESC_HI) = virtio_addr_hi(&vq->desc[0]);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_AVAIL_LO) = virtio_addr_lo(&vq->avail_flags);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_AVAIL_HI) = virtio_addr_hi(&vq->avail_flags);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_USED_LO) = virtio_addr_lo(&vq->used_flags);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_USED_HI) = virtio_addr_hi(&vq->used_flags);
+        *virtio_reg(base, VIRTIO_MMIO_QUEUE_READY) = 1;
+    }
+    return 0;
+}
+
+void virtio_ready(uintptr_t base) {
+    uint32_t status = *virtio_reg(base, VIRTIO_MMIO_STATUS);
+    *virtio_reg(base, VIRTIO_MMIO_STATUS) = status | VIRTIO_STATUS_DRIVER_OK;
+}
+
+void virtq_submit(virtq_t *vq, const virtq_buf_t *bufs, unsigned count) {
+    /* Chains always start at descriptor 0: only one is ever in flight */
+    for (unsigned i = 0; i < count; i++) {
+        vq->desc[i].addr = (uint64_t)(uintptr_t)bufs[i].addr;
+        vq->desc[i].len = bufs[i].len;
+        vq->desc[i].flags = bufs[i].flags;
+        vq->desc[i].next = (uint16_t)(i + 1);
+        if (i + 1 < count) {
+            vq->desc[i].flags |= VIRTQ_DESC_F_NEXT;
+        }
+    }
+
+    vq->avail_ring[vq->avail_idx % VIRTQ_SIZE] = 0;
+    virtio_mb();
+    vq->avail_idx++;
+    virtio_mb();
+    *virtio_reg(vq->base, VIRTIO_MMIO_QUEUE_NOTIFY) = vq->index;
+}
+
+int virtq_poll(virtq_t *vq, uint32_t *len) {
+    if (vq->used_idx == vq->last_used) {
+        return 0;
+    }
+    virtio_mb();
+    if (len) {
+        *len = vq->used_ring[vq->last_used % VIRTQ_SIZE].len;
+    }
+    vq->last_used++;
+
+    /* Nobody listens to the interrupt line; keep it deasserted anyway */
+    *virtio_reg(vq->base, VIRTIO_MMIO_INT_ACK) = *virtio_reg(vq->base, VIRTIO_MMIO_INT_STATUS);
+    return 1;
+}
+
+uint32_t virtq_transfer(virtq_t *vq, const virtq_buf_t *bufs, unsigned count) {
+    uint32_t len = 0;
+    virtq_submit(vq, bufs, count);
+    while (!virtq_poll(vq, &len));
+    return len;
+}
@@ -0,0 +1,194 @@
+#ifndef VIRTIO_H
+#define VIRTIO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Minimal polled virtio-mmio transport (QEMU virt board)
+ *
+ * Supports both the legacy (version 1, QEMU default) and modern (version 2,
+ * -global virtio-mmio.force-legacy=false) register layouts. Queues are tiny
+ * and driven synchronously: one descriptor chain in flight, completion is
+ * detected by polling the used ring. No interrupts are used.
+ */
+
+/* QEMU virt exposes 8 virtio-mmio slots, 4 KB apart */
+#define VIRTIO_MMIO_BASE        0x10001000
+#define VIRTIO_MMIO_STRIDE      0x1000
+#define VIRTIO_MMIO_SLOTS       8
+
+/* Device IDs */
+#define VIRTIO_DEV_BLK          2
+#define VIRTIO_DEV_CONSOLE      3
+
+/* Register offsets */
+#define VIRTIO_MMIO_MAGIC           0x000
+#define VIRTIO_MMIO_VERSION         0x004
+#define VIRTIO_MMIO_DEVICE_ID       0x008
+#define VIRTIO_MMIO_DEV_FEATURES    0x010
+#define VIRTIO_MMIO_DEV_FEATURES_SEL 0x014
+#define VIRTIO_MMIO_DRV_FEATURES    0x020
+#define VIRTIO_MMIO_DRV_FEATURES_SEL 0x024
+#define VIRTIO_MMIO_GUEST_PAGE_SIZE 0x028   /* legacy only */
+#define VIRTIO_MMIO_QUEUE_SEL       0x030
+#define VIRTIO_MMIO_QUEUE_NUM_MAX   0x034
+#define VIRTIO_MMIO_QUEUE_NUM       0x038
+#define VIRTIO_MMIO_QUEUE_ALIGN     0x03c   /* legacy only */
+#define VIRTIO_MMIO_QUEUE_PFN       0x040   /* legacy only */
+#define VIRTIO_MMIO_QUEUE_READY     0x044   /* modern only */
+#define VIRTIO_MMIO_QUEUE_NOTIFY    0x050
+#define VIRTIO_MMIO_INT_STATUS      0x060
+#define VIRTIO_MMIO_INT_ACK         0x064
+#define VIRTIO_MMIO_STATUS          0x070
+#define VIRTIO_MMIO_QUEUE_DESC_LO   0x080   /* modern only */
+#define VIRTIO_MMIO_QUEUE_DESC_HI   0x084
+#define VIRTIO_MMIO_QUEUE_AVAIL_LO  0x090
+#define VIRTIO_MMIO_QUEUE_AVAIL_HI  0x094
+#define VIRTIO_MMIO_QUEUE_USED_LO   0x0a0
+#define VIRTIO_MMIO_QUEUE_USED_HI   0x0a4
+#define VIRTIO_MMIO_CONFIG          0x100
+
+#define VIRTIO_MMIO_MAGIC_VALUE     0x74726976 /* "virt" */
+
+/* Device status bits */
+#define VIRTIO_STATUS_ACK           0x01
+#define VIRTIO_STATUS_DRIVER        0x02
+#define VIRTIO_STATUS_DRIVER_OK     0x04
+#define VIRTIO_STATUS_FEATURES_OK   0x08
+#define VIRTIO_STATUS_FAILED        0x80
+
+/* Descriptor flags */
+#define VIRTQ_DESC_F_NEXT           0x01
+#define VIRTQ_DESC_F_WRITE          0x02   /* device writes (driver reads) */
+
+/*
+ * Queue geometry. A descriptor chain never exceeds 3 entries, so 8 is
+ * plenty. Legacy devices compute the used ring position from QueueAlign;
+ * 64 keeps the layout below valid regardless of whether the device counts
+ * the avail->used_event field.
+ */
+#define VIRTQ_SIZE                  8
+#define VIRTQ_LEGACY_ALIGN          64
+#define VIRTQ_LEGACY_PAGE           512
+
+typedef struct {
+    uint64_t addr;
+    uint32_t len;
+    uint16_t flags;
+    uint16_t next;
+} virtq_desc_t;
+
+typedef struct {
+    uint32_t id;
+    uint32_t len;
+} virtq_used_elem_t;
+
+typedef struct {
+    /* Device-visible rings (layout fixed by the virtio spec) */
+    virtq_desc_t desc[VIRTQ_SIZE];
+    uint16_t avail_flags;
+    uint16_t avail_idx;
+    uint16_t avail_ring[VIRTQ_SIZE];
+    uint16_t used_event;
+    uint8_t  pad[VIRTQ_LEGACY_ALIGN * 3 - sizeof(virtq_desc_t) * VIRTQ_SIZE
+                 - 2 * (3 + VIRTQ_SIZE)];
+    uint16_t used_flags;
+    volatile uint16_t used_idx;
+    virtq_used_elem_t used_ring[VIRTQ_SIZE];
+    uint16_t avail_event;
+
+    /* Driver bookkeeping (not seen by the device) */
+    uintptr_t base;         /* MMIO base of the owning device */
+    uint32_t index;         /* Queue index on that device */
+    uint16_t last_used;     /* Last used_idx consumed */
+} __attribute__((aligned(VIRTQ_LEGACY_PAGE))) virtq_t;
+
+/* One buffer of a descriptor chain */
+typedef struct {
+    void *addr;
+    uint32_t len;
+    uint16_t flags;         /* VIRTQ_DESC_F_WRITE for device-written buffers */
+} virtq_buf_t;
+
+/**
+ * virtio_find - Locate a virtio-mmio device by device ID
+ * @device_id: VIRTIO_DEV_* value
+ *
+ * Returns: MMIO base address, or 0 if no such device is attached
+ */
+uintptr_t virtio_find(uint32_t device_id);
+
+/**
+ * virtio_set_slots - Search these MMIO bases instead of the fixed layout
+ * @base: Slot addresses (e.g. fdt_info_t.virtio_base)
+ * @count: Number of entries, at most FDT_MAX_VIRTIO
+ */
+void virtio_set_slots(const uintptr_t *base, uint32_t count);
+
+/**
+ * virtio_setup - Reset a device and negotiate features
+ * @base: MMIO base returned by virtio_find()
+ * @features: Device feature bits 0..31 the driver accepts
+ *
+ * Returns: 0 on success, -1 if the device rejects the feature set
+ */
+int virtio_setup(uintptr_t base, uint32_t features);
+
+/**
+ * virtio_queue_init - Register a virtqueue with the device
+ * @base: MMIO base
+ * @index: Queue index
+ * @vq: Queue storage (must stay valid while the device is live)
+ *
+ * Returns: 0 on success, -1 if the queue is unavailable or too small
+ */
+int virtio_queue_init(uintptr_t base, uint32_t index, virtq_t *vq);
+
+/**
+ * virtio_ready - Set DRIVER_OK; the device is live after this call
+ * @base: MMIO base
+ */
+void virtio_ready(uintptr_t base);
+
+/**
+ * virtq_submit - Post a descriptor chain without waiting for it
+ * @vq: Queue
+ * @bufs: Chain buffers, in order
+ * @count: Number of buffers (at most VIRTQ_SIZE)
+ */
+void virtq_submit(virtq_t *vq, const virtq_buf_t *bufs, unsigned count);
+
+/**
+ * virtq_poll - Check whether the device has completed a chain
+ * @vq: Queue
+ * @len: If non-NULL, receives the number of bytes the device wrote
+ *
+ * Returns: 1 if a chain completed (and was consumed), 0 otherwise
+ */
+int virtq_poll(virtq_t *vq, uint32_t *len);
+
+/**
+ * virtq_transfer - Post a descriptor chain and spin until it completes
+ * @vq: Queue
+ * @bufs: Chain buffers, in order
+ * @count: Number of buffers
+ *
+ * Returns: bytes written by the device
+ */
+uint32_t virtq_transfer(virtq_t *vq, const virtq_buf_t *bufs, unsigned count);
+
+static inline volatile uint32_t *virtio_reg(uintptr_t base, uint32_t off) {
+    return (volatile uint32_t *)(base + off);
+}
+
+/* 64-bit bus address halves for the modern LO/HI register pairs */
+static inline uint32_t virtio_addr_lo(const volatile void *p) {
+    return (uint32_t)(uintptr_t)p;
+}
+
+static inline uint32_t virtio_addr_hi(const volatile void *p) {
+    return (uint32_t)((uint64_t)(uintptr_t)p >> 32);
+}
+
+#endif /* VIRTIO_H */
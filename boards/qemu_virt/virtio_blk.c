@@ -0,0 +1,75 @@
+#include "boot.h"
+#include "virtio.h"
+
+/*
+ * QEMU Virt Block Device (virtio-blk over virtio-mmio)
+ *
+ * Implements the platform_blk_* HAL used as a bulk firmware image source.
+ * Attach a disk with e.g.:
+ *   -drive file=app.img,if=none,format=raw,id=d0 -device virtio-blk-device,drive=d0
+ *
+ * PORTING NOTES:
+ * - Boards without a block device implement platform_blk_init() returning 0
+ * - SD/eMMC/SPI-NAND ports map platform_blk_read() onto their sector reads
+ */
+
+#define VIRTIO_BLK_T_IN         0
+#define VIRTIO_BLK_S_OK         0
+
+/* Config space: 64-bit capacity in 512-byte sectors */
+#define VIRTIO_BLK_CFG_CAPACITY_LO (VIRTIO_MMIO_CONFIG + 0)
+#define VIRTIO_BLK_CFG_CAPACITY_HI (VIRTIO_MMIO_CONFIG + 4)
+
+typedef struct {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t sector;
+} virtio_blk_req_t;
+
+static virtq_t blk_vq;
+static virtio_blk_req_t blk_req;
+static volatile uint8_t blk_status;
+static uint32_t blk_sectors;
+
+uint32_t platform_blk_init(void) {
+    blk_sectors = 0;
+
+    uintptr_t base = virtio_find(VIRTIO_DEV_BLK);
+    if (base == 0) {
+        return 0;
+    }
+    /* No optional features: plain sector reads are all we need */
+    if (virtio_setup(base, 0) != 0 || virtio_queue_init(base, 0, &blk_vq) != 0) {
+        return 0;
+    }
+    virtio_ready(base);
+
+    /* Clamp to 32-bit sector numbers (2 TB); far beyond any image */
+    if (*virtio_reg(base, VIRTIO_BLK_CFG_CAPACITY_HI) != 0) {
+        blk_sectors = 0xFFFFFFFFU;
+    } else {
+        blk_sectors = *virtio_reg(base, VIRTIO_BLK_CFG_CAPACITY_LO);
+    }
+    return blk_sectors;
+}
+
+int platform_blk_read(uint32_t lba, void *buf, size_t count) {
+    if (blk_sectors == 0 || count == 0 || lba + count > blk_sectors || lba + count < lba) {
+        return -1;
+    }
+
+    blk_req.type = VIRTIO_BLK_T_IN;
+    blk_req.reserved = 0;
+    blk_req.sector = lba;
+    blk_status = 0xFF;
+
+    /* header (device reads) -> data (device writes) -> status (device writes) */
+    virtq_buf_t chain[3] = {
+        { &blk_req, sizeof(blk_req), 0 },
+        { buf, (uint32_t)(count * BLK_SECTOR_SIZE), VIRTQ_DESC_F_WRITE },
+        { (void *)&blk_status, 1, VIRTQ_DESC_F_WRITE },
+    };
+    virtq_transfer(&blk_vq, chain, 3);
+
+    return (blk_status == VIRTIO_BLK_S_OK) ? 0 : -1;
+}
@@ -0,0 +1,103 @@
+#include "boot.h"
+#include "virtio.h"
+
+/*
+ * QEMU Virt Auxiliary Console (virtio-console over virtio-mmio)
+ *
+ * Implements the platform_console_* HAL. Data moves in descriptor-chain
+ * buffers, so a whole protocol chunk costs one notify instead of one MMIO
+ * access per byte. Attach with e.g.:
+ *   -device virtio-serial-device -chardev socket,id=vc0,port=10001,host=localhost,server=on,wait=off
+ *   -device virtconsole,chardev=vc0
+ *
+ * Single port (no VIRTIO_CONSOLE_F_MULTIPORT): queue 0 = RX, queue 1 = TX.
+ */
+
+#define CON_RX_BUF_SIZE     512
+
+static virtq_t con_rxq;
+static virtq_t con_txq;
+static uint8_t con_rx_buf[CON_RX_BUF_SIZE];
+static uint32_t con_rx_len;
+static uint32_t con_rx_pos;
+static int con_rx_posted;
+static int con_live;
+
+static void con_post_rx(void) {
+    virtq_buf_t buf = { con_rx_buf, CON_RX_BUF_SIZE, VIRTQ_DESC_F_WRITE };
+    con_rx_len = 0;
+    con_rx_pos = 0;
+    con_rx_posted = 1;
+    virtq_submit(&con_rxq, &buf, 1);
+}
+
+/* Make buffered RX data available; returns non-zero if any is pending */
+static int con_rx_fill(void) {
+    if (con_rx_pos < con_rx_len) {
+        return 1;
+    }
+    if (!con_rx_posted) {
+        con_post_rx();
+    }
+
+    uint32_t len;
+    if (!virtq_poll(&con_rxq, &len)) {
+        return 0;
+    }
+    con_rx_posted = 0;
+    con_rx_len = (len > CON_RX_BUF_SIZE) ? CON_RX_BUF_SIZE : len;
+    con_rx_pos = 0;
+    return con_rx_len != 0;
+}
+
+int platform_console_init(void) {
+    con_live = 0;
+
+    uintptr_t base = virtio_find(VIRTIO_DEV_CONSOLE);
+    if (base == 0) {
+        return -1;
+    }
+    if (virtio_setup(base, 0) != 0 ||
+        virtio_queue_init(base, 0, &con_rxq) != 0 ||
+        virtio_queue_init(base, 1, &con_txq) != 0) {
+        return -1;
+    }
+    virtio_ready(base);
+
+    con_post_rx();
+    con_live = 1;
+    return 0;
+}
+
+int platform_console_rx_ready(void) {
+    return con_live && con_rx_fill();
+}
+
+void platform_console_read(uint8_t *buf, size_t len) {
+    while (len) {
+        while (!con_rx_fill());
+
+        size_t n = con_rx_len - con_rx_pos;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(buf, &con_rx_buf[con_rx_pos], n);
+        con_rx_pos += n;
+        buf += n;
+        len -= n;
+
+        /* Hand the buffer back as soon as it is drained */
+        if (con_rx_pos == con_rx_len) {
+            con_post_rx();
+        }
+    }
+}
+
+void platform_console_write(const uint8_t *buf, size_t len) {
+    if (!con_live || len == 0) {
+        return;
+    }
+    /* Zero-copy: the device reads straight from the caller's buffer */
+    virtq_buf_t chain = { (void *)buf, (uint32_t)len, 0 };
+    virtq_transfer(&con_txq, &chain, 1);
+}
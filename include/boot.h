@@ -4,19 +4,99 @@
 #include <stdint.h>
 #include <stddef.h>
 
-/* Platform-specific configuration - Import from board */
-#include "../boards/qemu_virt/platform.h"
+/* Platform-specific configuration - from boards/$(BOARD) (make BOARD=<name>) */
+#include "platform.h"
+#include "fw_layout.h"
+
+/* Flash geometry feeds masks and shifts: it must be a power of two */
+_Static_assert((FLASH_SECTOR_SIZE & (FLASH_SECTOR_SIZE - 1)) == 0, "FLASH_SECTOR_SIZE");
+_Static_assert((FLASH_PAGE_SIZE & (FLASH_PAGE_SIZE - 1)) == 0, "FLASH_PAGE_SIZE");
+_Static_assert(FLASH_SECTOR_SIZE % FLASH_PAGE_SIZE == 0, "FLASH_PAGE_SIZE");
+_Static_assert(APP_BASE % FLASH_SECTOR_SIZE == 0 && APP_MAX_SIZE % FLASH_SECTOR_SIZE == 0,
+               "APP partition must be sector aligned");
+_Static_assert(STATE_BASE % FLASH_SECTOR_SIZE == 0 && STATE_SIZE % FLASH_SECTOR_SIZE == 0,
+               "STATE sector must be sector aligned");
+/* SEND sizes are parsed in 32 bits: one more digit past the largest valid
+ * size must not wrap (see uart_update()) */
+_Static_assert(APP_MAX_SIZE < 0xFFFFFFFFu / 10, "APP_MAX_SIZE too large for 32-bit sizes");
 
 /* Bootloader Configuration */
 #define BOOT_MAGIC          0x5256424C /* "RVBL" */
 
-/* Firmware Header */
+/*
+ * RAM-resident hot paths: start.S copies these to RAM along with .data, so
+ * the receive/flash-poll loops run at RAM speed and keep running while the
+ * flash bank they would otherwise execute from is busy programming. That
+ * only holds if everything reached between a flash submit and its
+ * completion is RAMFUNC (callees included), and that starts inside the
+ * submit call: its return runs with the operation in flight.
+ * Flash-resident code may run once the operation has completed. noinline keeps the RAM copy the only
+ * copy. RAMDATA is for read-only tables (linker/memory.ld maps .ramfunc
+ * read/execute).
+ */
+#define RAMFUNC             __attribute__((section(".ramfunc"), noinline))
+#define RAMDATA             __attribute__((section(".ramfunc.data")))
+
+/* SHA-256 sizes */
+#define SHA256_DIGEST_SIZE  32
+#define SHA256_BLOCK_SIZE   64
+
+/* Ed25519 sizes */
+#define ED25519_KEY_SIZE    32
+#define ED25519_SIG_SIZE    64
+
+/* fw_header_t.flags */
+#define FW_FLAG_SHA256      (1u << 0)   /* sha256[] holds the body digest */
+#define FW_FLAG_SIGNED      (1u << 1)   /* signature[] signs sha256[] */
+#define FW_FLAG_DEFERRED    (1u << 2)   /* App may start before the payload check ends */
+
+/*
+ * FW_FLAG_DEFERRED contract (src/main.c, deferred_verify()): the image runs
+ * in place without modifying its partition, keeps out of RAM below
+ * RAM_BASE + BOOT_RAM_SIZE, and may be reset at any time until the worker
+ * hart has finished the check. On a mismatch the worker only marks the
+ * image in .noinit RAM and calls platform_reset(); the flash controller
+ * stays the app's, and the next boot records the failure in the boot state.
+ */
+
+/* Firmware Header (FW_HEADER_SIZE bytes; the application entry point follows it) */
 typedef struct {
     uint32_t magic;         /* Must be BOOT_MAGIC */
     uint32_t size;          /* Body size in bytes */
     uint32_t crc32;         /* CRC32 of the body */
     uint32_t version;       /* Firmware version */
+    uint32_t flags;         /* FW_FLAG_* */
+    uint32_t reserved[3];   /* Must be zero (checked) */
+    uint8_t  sha256[SHA256_DIGEST_SIZE]; /* SHA-256 of the body (optional) */
+    uint8_t  signature[ED25519_SIG_SIZE]; /* Ed25519 over sha256[] (optional) */
 } fw_header_t;
+_Static_assert(sizeof(fw_header_t) == FW_HEADER_SIZE, "fw_header_t must be FW_HEADER_SIZE (include/fw_layout.h)");
+
+/* Headers with nonzero reserved words are rejected at install and boot, so
+ * a later format can give those words a meaning */
+static inline int fw_header_reserved_clear(const fw_header_t *h) {
+    return (h->reserved[0] | h->reserved[1] | h->reserved[2]) == 0;
+}
+
+/* Streaming SHA-256 state (src/sha256.c) */
+typedef struct {
+    uint32_t state[8];
+    uint64_t total;                 /* Bytes hashed so far */
+    uint8_t  buf[SHA256_BLOCK_SIZE];
+    uint32_t buf_len;
+} sha256_ctx_t;
+
+/* Board facts discovered from the device tree (src/fdt.c) */
+#define FDT_MAX_VIRTIO      8
+
+typedef struct {
+    uintptr_t ram_base;     /* First /memory range (0 size = none found) */
+    uintptr_t ram_size;
+    uint32_t harts;         /* Enabled /cpus/cpu nodes */
+    uintptr_t uart_base;    /* First ns16550a, 0 = none */
+    uint32_t virtio_count;
+    uintptr_t virtio_base[FDT_MAX_VIRTIO]; /* virtio,mmio slots */
+} fdt_info_t;
 
 /* =============================================================================
  * HAL Layer 1: Platform-Specific (implemented in boards/<board>/platform.c)
@@ -34,6 +114,15 @@ typedef struct {
  */
 void platform_early_init(void);
 
+/**
+ * platform_discover - Adopt device-tree facts before any driver starts
+ * @fdt: Result of fdt_scan() (only called when a valid DTB was found)
+ *
+ * Called before uart_init(). Boards move their UART and virtio slots to the
+ * discovered addresses and ignore what they cannot use.
+ */
+void platform_discover(const fdt_info_t *fdt);
+
 /**
  * platform_uart_init - Initialize UART hardware
  * 
@@ -59,34 +148,168 @@ void platform_uart_putc(char c);
 char platform_uart_getc(void);
 
 /**
- * platform_flash_write - Write to flash memory
- * @addr: Absolute physical address to write
- * @data: Source buffer
- * @size: Number of bytes to write
- * 
- * Requirements for real hardware:
- * - addr/size must respect flash page alignment
- * - Target area must be erased first
- * - May need to disable cache/interrupts during write
- * 
- * Returns: 0 on success, -1 on error
+ * platform_uart_rx_ready - Check for pending RX data without blocking
+ *
+ * Returns: non-zero if platform_uart_getc() would return immediately
  */
-int platform_flash_write(uint32_t addr, const void *data, size_t size);
+int platform_uart_rx_ready(void);
 
 /**
- * platform_flash_erase - Erase flash memory
- * @addr: Absolute physical address (must be sector-aligned)
- * @size: Number of bytes to erase (must be multiple of sector size)
- * 
+ * platform_uart_set_rts - Drive the RTS handshake line (RTS/CTS boards)
+ * @on: 1 = ready to receive, 0 = hold off the sender
+ */
+void platform_uart_set_rts(int on);
+
+/**
+ * platform_uart_overruns - Receiver overruns seen so far (16550 LSR.OE)
+ *
+ * Every line status read checks OE, since reading LSR clears it.
+ */
+uint32_t platform_uart_overruns(void);
+
+/* Flash operations for platform_flash_submit() */
+#define FLASH_OP_WRITE      0
+#define FLASH_OP_ERASE      1
+
+/**
+ * flash_done_fn - Completion callback for an asynchronous flash operation
+ * @status: 0 on success, -1 if the operation failed
+ * @ctx: Caller context given at submit time
+ *
+ * Runs from platform_flash_poll() on the polling hart; may submit the next
+ * operation.
+ */
+typedef void (*flash_done_fn)(int status, void *ctx);
+
+/**
+ * platform_flash_submit - Start a flash operation without waiting for it
+ * @op: FLASH_OP_WRITE or FLASH_OP_ERASE
+ * @addr: Absolute physical address (erase: sector-aligned)
+ * @data: Write source, untouched by the caller until completion (erase: NULL)
+ * @size: Bytes to write / erase (erase: multiple of FLASH_SECTOR_SIZE)
+ * @done: Completion callback or NULL
+ * @ctx: Passed to @done
+ *
+ * One operation at a time. Programming and erasing take real time on
+ * hardware (erase: ms to seconds), so callers overlap other work (UART
+ * draining, checksums, watchdog) and poll.
+ *
  * Requirements for real hardware:
- * - addr must be sector-aligned
- * - size must be multiple of sector size
- * - May take significant time (ms to seconds)
- * - May need to disable interrupts/watchdog
- * 
+ * - write: addr/size respect flash page alignment, target erased first
+ * - erase: addr sector-aligned, size a multiple of the sector size
+ * - May need to disable cache/interrupts while the array is busy
+ *
+ * Returns: 0 if started, -1 on error (bad request or still busy)
+ */
+int platform_flash_submit(int op, uintptr_t addr, const void *data, size_t size,
+                          flash_done_fn done, void *ctx);
+
+/**
+ * platform_flash_poll - Check (and advance) the operation in progress
+ *
+ * Calls the completion callback once, when the operation finishes.
+ * Returns: 1 while busy, 0 when done (or idle), -1 if the operation failed
+ */
+int platform_flash_poll(void);
+
+/* Block devices use fixed 512-byte sectors */
+#define BLK_SECTOR_SIZE     512
+
+/**
+ * platform_blk_init - Probe and initialize the board's block device
+ *
+ * Optional bulk image source (e.g. virtio-blk, SD card). Safe to call more
+ * than once; each call re-initializes the device.
+ *
+ * Returns: capacity in BLK_SECTOR_SIZE sectors, 0 if no device is present
+ */
+uint32_t platform_blk_init(void);
+
+/**
+ * platform_blk_read - Read sectors from the block device
+ * @lba: First sector to read
+ * @buf: Destination buffer in RAM (count * BLK_SECTOR_SIZE bytes)
+ * @count: Number of sectors
+ *
+ * Blocks until the transfer completes (polled, no interrupts).
+ *
+ * Returns: 0 on success, -1 on error or out-of-range request
+ */
+int platform_blk_read(uint32_t lba, void *buf, size_t count);
+
+/**
+ * platform_hostimg_open - Look for a host-provided firmware image
+ *
+ * Optional provisioning source that needs no UART transfer (QEMU: fw_cfg
+ * entry "opt/rvbl/app"). Checked once at boot.
+ *
+ * Returns: image size in bytes, 0 if the host provides no image
+ */
+uint32_t platform_hostimg_open(void);
+
+/**
+ * platform_hostimg_read - Copy part of the host-provided image
+ * @offset: Byte offset into the image
+ * @buf: Destination buffer in RAM
+ * @len: Number of bytes
+ *
  * Returns: 0 on success, -1 on error
  */
-int platform_flash_erase(uint32_t addr, size_t size);
+int platform_hostimg_read(uint32_t offset, void *buf, size_t len);
+
+/**
+ * platform_console_init - Bring up the auxiliary high-bandwidth console
+ *
+ * Optional second byte channel for the update protocol that moves data in
+ * large buffers instead of per-byte register accesses (QEMU: virtio-console).
+ *
+ * Returns: 0 if the console is present and ready, -1 otherwise
+ */
+int platform_console_init(void);
+
+/**
+ * platform_console_rx_ready - Check for pending console RX data
+ *
+ * Returns: non-zero if at least one byte can be read without blocking
+ */
+int platform_console_rx_ready(void);
+
+/**
+ * platform_console_read - Receive exactly @len bytes from the console
+ * @buf: Destination buffer
+ * @len: Number of bytes (blocks until all have arrived)
+ */
+void platform_console_read(uint8_t *buf, size_t len);
+
+/**
+ * platform_console_write - Send @len bytes to the console
+ * @buf: Source buffer (must be RAM the device can read)
+ * @len: Number of bytes (blocks until the device has consumed them)
+ */
+void platform_console_write(const uint8_t *buf, size_t len);
+
+/**
+ * platform_update_key - Device key for encrypted updates
+ * @key: Receives a pointer to the key bytes
+ *
+ * Returns: key length (16 = AES-128, 32 = AES-256), 0 if the board has no key
+ */
+size_t platform_update_key(const uint8_t **key);
+
+/**
+ * platform_hart_start - Release a hart parked by start.S
+ * @hart: Hart ID
+ *
+ * Everything written before the call is visible to the released hart.
+ */
+void platform_hart_start(unsigned hart);
+
+/**
+ * platform_hart_wait_start - Park the calling hart until released
+ *
+ * Called before .bss/.data are initialized: must not use globals.
+ */
+void platform_hart_wait_start(void);
 
 /**
  * platform_reset - Perform system reset
@@ -121,6 +344,22 @@ void uart_putc(char c);
  */
 char uart_getc(void);
 
+/**
+ * uart_rx_ready - Drain the RX FIFO into the RX ring, check for data
+ *
+ * Call while busy with other work (flash polls): the ring absorbs what the
+ * small hardware FIFO cannot, and asserts flow control (XOFF and/or RTS
+ * low) above UART_RX_HIGH_WATER bytes until it drains to UART_RX_LOW_WATER.
+ * Returns: non-zero if uart_getc() would return immediately
+ */
+int uart_rx_ready(void);
+
+#define UART_RX_RING_SIZE   512     /* Power of two */
+#define UART_RX_HIGH_WATER  (UART_RX_RING_SIZE * 3 / 4)
+#define UART_RX_LOW_WATER   (UART_RX_RING_SIZE / 4)
+#define UART_XON            0x11
+#define UART_XOFF           0x13
+
 /**
  * uart_puts - Send a null-terminated string
  * @s: String to send
@@ -128,21 +367,216 @@ char uart_getc(void);
 void uart_puts(const char *s);
 
 /**
- * flash_write - Safe flash write with bounds checking
- * @addr: Address to write (must be within APP region)
+ * uart_put_dec - Send an unsigned value in decimal
+ * @value: Value to print
+ */
+void uart_put_dec(uint32_t value);
+
+/**
+ * emit_bl_evt - Emit a canonical BL_EVT:<TOKEN> line on the UART log
+ * @token: Token name
+ */
+void emit_bl_evt(const char *token);
+
+/**
+ * emit_bl_evt_u32 - Emit BL_EVT:<TOKEN>:<VALUE> (decimal)
+ * @token: Token name
+ * @value: Value
+ */
+void emit_bl_evt_u32(const char *token, uint32_t value);
+
+/**
+ * emit_bl_evt_progress - Emit BL_EVT:UPDATE_PROGRESS:<bytes> mid-transfer
+ * @bytes: Payload bytes done so far
+ *
+ * Safe while a transfer is arriving on the UART: each character sent
+ * takes as long as one received, so the RX FIFO is moved into the ring
+ * after every character instead of overflowing behind the line.
+ */
+void emit_bl_evt_progress(uint32_t bytes);
+
+/* Runtime counters (src/stats.c), reported as BL_EVT:STAT_* */
+typedef struct {
+    uint32_t uart_rx_peak;          /* Highest RX ring fill level */
+    uint32_t uart_flow_stops;       /* Times backpressure was asserted */
+    uint32_t arena_peak;            /* Scratch arena high-water mark (bytes) */
+} boot_stats_t;
+
+extern boot_stats_t boot_stats;
+
+/**
+ * stats_report - Emit the runtime counters
+ *
+ * BL_EVT:STAT_UART_OVERRUN / STAT_UART_RX_PEAK / STAT_UART_FLOW_STOP /
+ * STAT_ARENA_PEAK / STAT_STACK_PEAK
+ */
+void stats_report(void);
+
+/**
+ * stats_stack_peak - Deepest main-stack use so far, in bytes
+ *
+ * Found by scanning the paint pattern start.S writes over the stack.
+ * Return: Bytes below _stack_top that have been written
+ */
+uint32_t stats_stack_peak(void);
+
+/* =============================================================================
+ * Scratch Arena (implemented in src/arena.c)
+ * ============================================================================= */
+
+/**
+ * arena_alloc - Bump-allocate scratch memory from the ARENA region
+ * @size: Bytes (rounded up to 8-byte alignment)
+ *
+ * Large buffers that are only needed in one boot phase (install staging,
+ * update receive buffers, benchmark scratch) come from here instead of
+ * being reserved as separate static arrays. There is no free(): release
+ * a whole phase with arena_release().
+ * Returns: 8-byte aligned memory, or NULL if the arena is exhausted
+ */
+void *arena_alloc(size_t size);
+
+/**
+ * arena_mark / arena_release - Phase scope
+ *
+ * arena_mark() returns the current fill level; arena_release(mark) frees
+ * everything allocated since. Phases nest like a stack.
+ */
+size_t arena_mark(void);
+void arena_release(size_t mark);
+
+/**
+ * arena_grow - Extend the arena over RAM found at boot
+ * @end: New end address; must continue the RAM that ends at _arena_end
+ *
+ * The linked ARENA region is the compile-time minimum. Called once at boot
+ * with the end of the discovered RAM (see fdt_usable_end()); an @end below
+ * the current end is ignored.
+ * Returns: Arena capacity in bytes
+ */
+size_t arena_grow(uintptr_t end);
+
+/* =============================================================================
+ * Device Tree Discovery (implemented in src/fdt.c)
+ * ============================================================================= */
+
+/* DTB address the previous stage passed in a1 (stored by start.S) */
+extern uintptr_t fdt_boot_blob;
+
+/**
+ * fdt_scan - Read board facts from a flattened device tree
+ * @blob: DTB address; 0 or memory without an FDT header is rejected
+ * @info: Filled in; zeroed if the blob is rejected
+ *
+ * Read-only, single pass, no allocation. Version 17 blobs only.
+ * Returns: 0 on success, -1 if there is no valid DTB at @blob
+ */
+int fdt_scan(const void *blob, fdt_info_t *info);
+
+/**
+ * fdt_usable_end - Trim a free RAM range against the DTB itself
+ * @blob: DTB address
+ * @from: Start of the range the caller wants to use
+ * @end: End of that range (e.g. end of the /memory node)
+ *
+ * Returns: @end lowered to the first byte of the blob or of a
+ * /memreserve/ entry that lies within [@from, @end)
+ */
+uintptr_t fdt_usable_end(const void *blob, uintptr_t from, uintptr_t end);
+
+/**
+ * transport_t - Byte channel carrying the update protocol
+ *
+ * Bulk read/write operations let high-bandwidth channels (descriptor-based
+ * consoles) move whole chunks per call instead of one MMIO access per byte.
+ */
+typedef struct {
+    const char *name;
+    int (*rx_ready)(void);                          /* Non-blocking RX check */
+    void (*read)(uint8_t *buf, size_t len);         /* Blocks for exactly len bytes */
+    void (*write)(const uint8_t *buf, size_t len);  /* Blocks until sent */
+} transport_t;
+
+/* 16550 UART transport (always available) */
+extern const transport_t transport_uart;
+
+/**
+ * transport_console_open - Auxiliary console transport, if the board has one
+ *
+ * Returns: transport, or NULL if platform_console_init() fails
+ */
+const transport_t *transport_console_open(void);
+
+/**
+ * transport_getc - Receive one byte from a transport
+ * @t: Transport
+ */
+char transport_getc(const transport_t *t);
+
+/**
+ * transport_putc - Send one character (with \n -> \r\n normalization)
+ * @t: Transport
+ * @c: Character
+ */
+void transport_putc(const transport_t *t, char c);
+
+/**
+ * transport_puts - Send a NUL-terminated string (with \n -> \r\n)
+ * @t: Transport
+ * @s: String
+ */
+void transport_puts(const transport_t *t, const char *s);
+
+/**
+ * flash_submit - Bounds-checked platform_flash_submit()
+ *
+ * Only the APP partition and the boot state sector are accepted; the
+ * bootloader itself is never written.
+ * Returns: 0 if started, -1 if out of bounds or the platform refused
+ */
+int flash_submit(int op, uintptr_t addr, const void *data, size_t size,
+                 flash_done_fn done, void *ctx);
+
+/**
+ * flash_poll / flash_wait - Progress of the operation in flight
+ *
+ * flash_poll() returns 1 while busy, 0 when done, -1 on failure;
+ * flash_wait() polls until the operation finishes and returns 0 or -1.
+ */
+int flash_poll(void);
+int flash_wait(void);
+
+/**
+ * flash_write - Safe flash write with bounds checking (blocking)
+ * @addr: Address to write (APP partition or boot state sector)
  * @data: Source buffer
  * @size: Number of bytes to write
  * 
  * Returns: 0 on success, -1 if out of bounds or write fails
  */
-int flash_write(uint32_t addr, const void *data, size_t size);
+int flash_write(uintptr_t addr, const void *data, size_t size);
+
+/* flash_write_start - Start a bounds-checked write; finish with flash_poll() */
+int flash_write_start(uintptr_t addr, const void *data, size_t size);
 
 /**
- * flash_erase_app - Erase entire application partition
- * 
+ * flash_erase - Erase whole sectors with bounds checking (blocking)
+ * @addr: Sector-aligned address (APP partition or boot state sector)
+ * @size: Multiple of FLASH_SECTOR_SIZE
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int flash_erase(uintptr_t addr, size_t size);
+
+/**
+ * flash_erase_app - Erase the start of the application partition
+ * @size: Bytes that will be written from APP_BASE (header included)
+ *
+ * Erases only the sectors covering @size, skipping blank ones, so the
+ * cost follows the image rather than the partition (multi-MB layouts).
  * Returns: 0 on success, -1 on error
  */
-int flash_erase_app(void);
+int flash_erase_app(uint32_t size);
 
 /**
  * flash_write_header - Write firmware header atomically
@@ -153,6 +587,326 @@ int flash_erase_app(void);
  */
 int flash_write_header(const fw_header_t *header);
 
+/* =============================================================================
+ * Image Install Pipeline (implemented in src/image.c)
+ * ============================================================================= */
+
+/* Staging chunk size used when pulling an image from a source */
+#define IMAGE_CHUNK_SIZE    4096
+
+/* image_* error codes */
+#define IMAGE_OK            0
+#define IMAGE_BUSY          1       /* image_poll(): write still in progress */
+#define IMAGE_ERR_SIZE     -1
+#define IMAGE_ERR_ERASE    -2
+#define IMAGE_ERR_WRITE    -3
+#define IMAGE_ERR_CRC      -4
+#define IMAGE_ERR_HEADER   -5
+#define IMAGE_ERR_READ     -6
+#define IMAGE_ERR_NOMEM    -7       /* Scratch arena exhausted */
+
+/* Streaming writer state for one image install */
+typedef struct {
+    fw_header_t header;     /* Header committed by image_finish() */
+    uint32_t written;       /* Payload bytes written so far */
+    uint32_t crc;           /* Running CRC32 over the payload */
+    sha256_ctx_t sha;       /* Running SHA-256 over the payload */
+    int packed;             /* Header came with the image (CRC must match) */
+} image_writer_t;
+
+/**
+ * image_begin - Start installing an image into the APP partition
+ * @w: Writer state
+ * @packed: Header shipped with the image, or NULL for a raw payload
+ * @size: Payload size in bytes (ignored when @packed is given)
+ *
+ * Validates the size (and a packed header's reserved words) and erases the
+ * partition.
+ * Returns: IMAGE_OK or IMAGE_ERR_SIZE/IMAGE_ERR_HEADER/IMAGE_ERR_ERASE
+ */
+int image_begin(image_writer_t *w, const fw_header_t *packed, uint32_t size);
+
+/**
+ * image_feed - Append payload bytes
+ * @w: Writer state
+ * @data: Payload bytes, in order
+ * @len: Number of bytes
+ *
+ * Returns: IMAGE_OK or IMAGE_ERR_SIZE/IMAGE_ERR_WRITE
+ */
+int image_feed(image_writer_t *w, const uint8_t *data, size_t len);
+
+/**
+ * image_feed_start - Append payload bytes, programming in the background
+ * @w: Writer state
+ * @data: Payload bytes; must stay untouched until image_poll() is done
+ * @len: Number of bytes
+ *
+ * CRC/SHA-256 run on @data while the flash is busy. Poll the previous
+ * write to completion before starting the next.
+ * Returns: IMAGE_OK or IMAGE_ERR_SIZE/IMAGE_ERR_WRITE
+ */
+int image_feed_start(image_writer_t *w, const uint8_t *data, size_t len);
+
+/**
+ * image_poll - Advance the write started by image_feed_start()
+ * @w: Writer state
+ *
+ * Returns: IMAGE_BUSY, IMAGE_OK once done, or IMAGE_ERR_WRITE
+ */
+int image_poll(image_writer_t *w);
+
+/**
+ * image_finish - Check the payload and commit the header
+ * @w: Writer state
+ *
+ * The header is written last so a partial install never looks valid.
+ * Returns: IMAGE_OK or IMAGE_ERR_SIZE/IMAGE_ERR_CRC/IMAGE_ERR_HEADER
+ */
+int image_finish(image_writer_t *w);
+
+/**
+ * image_read_fn - Random-access reader for an image source
+ * @offset: Byte offset into the source (always IMAGE_CHUNK_SIZE aligned)
+ * @buf: Destination, IMAGE_CHUNK_SIZE bytes available
+ * @len: Bytes requested (at most IMAGE_CHUNK_SIZE)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+typedef int (*image_read_fn)(uint32_t offset, void *buf, size_t len);
+
+/**
+ * image_install - Pull an image from a source and install it
+ * @read: Source reader
+ * @avail: Bytes available from the source
+ *
+ * A source starting with a fw_header_t (BOOT_MAGIC) is installed as a
+ * packed image and its CRC must match; anything else is treated as a raw
+ * payload of @avail bytes.
+ *
+ * Returns: IMAGE_OK or a negative IMAGE_ERR_* code
+ */
+int image_install(image_read_fn read, uint32_t avail);
+
+/* Progress is reported each time this many payload bytes are done */
+#define IMAGE_PROGRESS_SHIFT 20     /* 1 MB */
+
+/**
+ * image_progress - Report progress if a transfer step crossed a boundary
+ * @before: Bytes done before the step
+ * @after: Bytes done after it
+ *
+ * Emits BL_EVT:UPDATE_PROGRESS once per 1 MB (nothing for small images).
+ */
+void image_progress(uint32_t before, uint32_t after);
+
+/* =============================================================================
+ * Debug Host Image Source (implemented in src/semihost.c)
+ * ============================================================================= */
+
+/**
+ * semihost_image_open - Open a file on the semihosting host
+ * @path: Host path, relative to the debugger/QEMU working directory
+ *
+ * Returns: file size in bytes, 0 if there is no host or no such file
+ */
+uint32_t semihost_image_open(const char *path);
+
+/**
+ * semihost_image_read - image_read_fn over the file opened above
+ */
+int semihost_image_read(uint32_t offset, void *buf, size_t len);
+
+/**
+ * semihost_image_close - Release the host file handle
+ */
+void semihost_image_close(void);
+
+/* =============================================================================
+ * Image Signature Verification (implemented in src/ed25519.c)
+ * ============================================================================= */
+
+/* Precomputed point multiples 1..15 in affine (y+x, y-x, 2dxy) form */
+#define ED25519_TABLE_SIZE  15
+
+typedef struct {
+    uint16_t ypx[16];
+    uint16_t ymx[16];
+    uint16_t xy2d[16];
+} ed25519_niels_t;
+
+/* Generated for the image signing key (src/ed25519_tables.c) */
+extern const uint8_t ed25519_public_key[ED25519_KEY_SIZE];
+extern const ed25519_niels_t ed25519_base_table[ED25519_TABLE_SIZE];
+extern const ed25519_niels_t ed25519_key_table[ED25519_TABLE_SIZE];
+
+/**
+ * ed25519_verify - Check an Ed25519 signature against the built-in key
+ * @sig: R || S
+ * @msg: Signed message (the image digest)
+ * @len: Message length in bytes
+ *
+ * Returns: 0 if the signature is valid, -1 otherwise
+ */
+int ed25519_verify(const uint8_t sig[ED25519_SIG_SIZE], const uint8_t *msg, size_t len);
+
+/* =============================================================================
+ * Update Decryption (implemented in src/aes.c)
+ * ============================================================================= */
+
+#define AES_BLOCK_SIZE      16
+#define AES_CTR_NONCE_SIZE  12
+
+/* Zkne round backend: aes32esi/aes32esmi exist on RV32 only (RV64 Zkne uses
+ * the aes64* forms), so RV64 builds keep the table rounds */
+#if defined(__riscv_zkne) && __riscv_xlen == 32
+#define AES_ZKNE            1
+#endif
+
+/* Expanded encryption key (AES-128: 10 rounds, AES-256: 14 rounds) */
+typedef struct {
+    uint32_t rk[60];
+    uint32_t rounds;
+} aes_ctx_t;
+
+/* CTR stream: counter block = nonce || 32-bit big-endian block index */
+typedef struct {
+    aes_ctx_t aes;
+    uint8_t  counter[AES_BLOCK_SIZE];
+    uint8_t  stream[AES_BLOCK_SIZE];    /* Current keystream block */
+    uint32_t used;                      /* Keystream bytes already consumed */
+} aes_ctr_t;
+
+/**
+ * aes_init - Expand an AES key
+ * @key_len: 16 (AES-128) or 32 (AES-256)
+ *
+ * Returns: 0 on success, -1 for an unsupported key length
+ */
+int aes_init(aes_ctx_t *ctx, const uint8_t *key, size_t key_len);
+
+/**
+ * aes_ctr_init - Start a CTR stream at block 0
+ *
+ * Returns: 0 on success, -1 for an unsupported key length
+ */
+int aes_ctr_init(aes_ctr_t *ctr, const uint8_t *key, size_t key_len,
+                 const uint8_t nonce[AES_CTR_NONCE_SIZE]);
+
+/**
+ * aes_ctr_xor - En/decrypt @len bytes in place, continuing the stream
+ *
+ * Uses the Zkne scalar crypto instructions when built for them, the
+ * table-driven rounds otherwise.
+ */
+void aes_ctr_xor(aes_ctr_t *ctr, uint8_t *data, size_t len);
+
+/* Single-block encryption backends (exposed for benchmarking) */
+void aes_encrypt_block_c(const aes_ctx_t *ctx, const uint8_t in[AES_BLOCK_SIZE],
+                         uint8_t out[AES_BLOCK_SIZE]);
+void aes_encrypt_block_zkne(const aes_ctx_t *ctx, const uint8_t in[AES_BLOCK_SIZE],
+                            uint8_t out[AES_BLOCK_SIZE]);
+
+/* =============================================================================
+ * Update Worker Hart (implemented in src/worker.c)
+ * ============================================================================= */
+
+#define WORKER_CHUNK_SIZE   256     /* One transport read */
+#define WORKER_RING_SLOTS   8
+
+typedef struct {
+    uint32_t len;
+    uint8_t data[WORKER_CHUNK_SIZE] __attribute__((aligned(8)));
+} worker_chunk_t;
+
+/**
+ * worker_main - Worker hart entry (called from start.S, returns to park)
+ *
+ * Waits for the start signal, then consumes chunks until worker_stop() or
+ * worker_handoff().
+ */
+void worker_main(void);
+
+/**
+ * worker_start - Release the worker hart and wait for it to come up
+ *
+ * Returns: 0 if the worker is online, -1 after PLATFORM_WORKER_START_TIMEOUT
+ */
+int worker_start(void);
+
+/* worker_online - 1 if worker_start() succeeded */
+int worker_online(void);
+
+/**
+ * worker_begin - Hand an update job to the worker
+ * @w: Writer from image_begin(); owned by the worker until worker_drain()
+ * @ctr: AES-CTR stream to decrypt with, or NULL for plaintext
+ */
+void worker_begin(image_writer_t *w, aes_ctr_t *ctr);
+
+/**
+ * worker_chunk_get / worker_chunk_put - Fill and publish the next chunk
+ *
+ * worker_chunk_get() returns NULL while all slots are in flight; set
+ * ->len before worker_chunk_put().
+ */
+worker_chunk_t *worker_chunk_get(void);
+void worker_chunk_put(worker_chunk_t *c);
+
+/**
+ * worker_drain - Wait until every published chunk has been processed
+ *
+ * Returns: IMAGE_OK or the first image_feed() error of the job
+ */
+int worker_drain(void);
+
+/* worker_stop - Park the worker before handing the machine to the app */
+void worker_stop(void);
+
+/**
+ * worker_handoff - Leave one last job to the worker and let the app run
+ * @fn: Runs on the worker hart once the chunk ring is idle; like the
+ *      worker itself it may only use the bootloader's static RAM (.data,
+ *      .bss, worker stack), never the main stack or the arena
+ * @arg: Passed to @fn
+ *
+ * The worker parks when @fn returns. Replaces worker_stop().
+ * Returns: 0 if the worker took the job, -1 if there is no worker
+ */
+int worker_handoff(void (*fn)(void *), void *arg);
+
+/* =============================================================================
+ * Persistent Boot State (implemented in src/state.c)
+ * ============================================================================= */
+
+#define STATE_MAGIC         0x54415453 /* "STAT" */
+
+/* One record at STATE_BASE, rewritten only when its contents change */
+typedef struct {
+    uint32_t magic;         /* STATE_MAGIC */
+    uint32_t key_tag;       /* CRC32 of the key that verified the image */
+    uint8_t  verified[SHA256_DIGEST_SIZE]; /* Digest with a verified signature */
+    uint32_t deferred_bad;  /* Header CRC32 of an image that failed a deferred check */
+    uint32_t host_image;    /* CRC32 of the last host image installed (fw_cfg, semihosting) */
+    uint32_t crc32;         /* CRC32 of the fields above */
+} boot_state_t;
+
+/**
+ * state_load - Read the persistent boot state
+ * @st: Receives the record; zeroed if none is stored or it is corrupt
+ *
+ * Returns: 0 if a valid record was read, -1 otherwise
+ */
+int state_load(boot_state_t *st);
+
+/**
+ * state_store - Replace the persistent boot state
+ * @st: Record to store (magic and crc32 are filled in)
+ *
+ * Returns: 0 on success, -1 on erase/write error
+ */
+int state_store(boot_state_t *st);
+
 /* =============================================================================
  * Utility Functions
  * ============================================================================= */
@@ -166,6 +920,153 @@ int flash_write_header(const fw_header_t *header);
  */
 uint32_t crc32(const uint8_t *data, size_t len);
 
+/**
+ * crc32_update - Continue a CRC32 over more data
+ * @crc: CRC32 of the data so far (0 for none)
+ * @data: Data buffer
+ * @len: Length in bytes
+ *
+ * crc32_update(crc32(a), b) == crc32(a || b)
+ * Returns: CRC32 value
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len);
+
+/* Zvbc folding backend (vclmul/vclmulh over 64-bit elements); crc32_update
+ * hands it buffers of CRC32_ZVBC_MIN bytes and more */
+#if defined(__riscv_zvbc)
+#define CRC32_ZVBC          1
+#define CRC32_ZVBC_MIN      256
+#endif
+
+/* Update backends (exposed for benchmarking) */
+uint32_t crc32_update_c(uint32_t crc, const uint8_t *data, size_t len);
+uint32_t crc32_update_zvbc(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * sha256_init / sha256_update / sha256_final - Streaming SHA-256
+ *
+ * Uses the Zknh scalar crypto instructions when built for them, the
+ * portable C rounds otherwise.
+ */
+void sha256_init(sha256_ctx_t *ctx);
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len);
+void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+/* Single-block compression backends (exposed for benchmarking) */
+void sha256_compress_c(uint32_t state[8], const uint8_t *block);
+void sha256_compress_zknh(uint32_t state[8], const uint8_t *block);
+
+/**
+ * cycle_count - Read the low 32 bits of the mcycle counter
+ *
+ * For measuring short intervals (wraps after 2^32 cycles).
+ */
+static inline uint32_t cycle_count(void) {
+    uint32_t c;
+    __asm__ volatile ("csrr %0, mcycle" : "=r"(c));
+    return c;
+}
+
+/**
+ * bench_run - Time the hot kernels and emit BL_EVT:BENCH_* results
+ *
+ * Only built with BENCH=1 (CONFIG_BENCH).
+ */
+void bench_run(void);
+
+/*
+ * Native register-width word (32 bits on RV32, 64 on RV64) for the wide
+ * copy/fill/CRC inner loops; may_alias makes byte buffers safe to walk.
+ */
+typedef uintptr_t __attribute__((may_alias)) word_t;
+#define WORD_SIZE           sizeof(word_t)
+
+/*
+ * Bit manipulation helpers
+ *
+ * ZBB=1 builds map these onto single Zbb/Zba instructions (rev8, ctz,
+ * sh1add/sh2add); the C fallbacks avoid the libgcc calls GCC would emit
+ * for __builtin_bswap32/__builtin_ctz on a bare RV32IM target.
+ */
+
+/* bswap32 - Byte-reverse a 32-bit value (big-endian <-> native) */
+static inline uint32_t bswap32(uint32_t v) {
+#if defined(__riscv_zbb)
+    uintptr_t r = v;
+    __asm__ ("rev8 %0, %0" : "+r"(r));
+#if __riscv_xlen == 64
+    r >>= 32;
+#endif
+    return (uint32_t)r;
+#else
+    return (v >> 24) | ((v >> 8) & 0xFF00U) | ((v << 8) & 0xFF0000U) | (v << 24);
+#endif
+}
+
+/* load_be32 - Read a big-endian 32-bit value from any address */
+static inline uint32_t load_be32(const uint8_t *p) {
+#if defined(__riscv_zbb)
+    if (((uintptr_t)p & 3) == 0) {
+        return bswap32(*(const uint32_t *)(const void *)p);
+    }
+#endif
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/* word_first_byte - Index of the lowest-addressed nonzero byte (w != 0) */
+static inline unsigned word_first_byte(word_t w) {
+#if defined(__riscv_zbb)
+    word_t n;
+    __asm__ ("ctz %0, %1" : "=r"(n) : "r"(w));
+    return (unsigned)(n >> 3);
+#else
+    unsigned i = 0;
+    while ((w & 0xFF) == 0) {
+        w >>= 8;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* dec_push - Append a decimal digit: v * 10 + digit */
+static inline uint32_t dec_push(uint32_t v, uint32_t digit) {
+#if defined(__riscv_zba)
+    uintptr_t t;
+    /* (v + 4v) * 2 + digit: two shifted adds instead of a multiply */
+    __asm__ ("sh2add %0, %1, %1\n\t"
+             "sh1add %0, %0, %2"
+             : "=&r"(t) : "r"((uintptr_t)v), "r"((uintptr_t)digit));
+    return (uint32_t)t;
+#else
+    return v * 10 + digit;
+#endif
+}
+
+/* Freestanding memory primitives (src/mem.c) */
+void *memcpy(void *dest, const void *src, size_t n);
+void *memset(void *dest, int c, size_t n);
+int memcmp(const void *a, const void *b, size_t n);
+
+/**
+ * mem_is_blank - Check that a buffer is all 0xFF (erased flash)
+ *
+ * Returns: 1 if every byte is 0xFF, 0 otherwise
+ */
+int mem_is_blank(const void *p, size_t n);
+
+/* Scalar word-wide implementations (exposed for benchmarking) */
+void *memcpy_scalar(void *dest, const void *src, size_t n);
+void *memset_scalar(void *dest, int c, size_t n);
+int memcmp_scalar(const void *a, const void *b, size_t n);
+int mem_is_blank_scalar(const void *p, size_t n);
+
+/* RVV kernels behind the primitives above (src/vec.c, RVV=1 builds only) */
+void vec_fill(void *dest, uint8_t value, size_t n);
+void vec_copy(void *dest, const void *src, size_t n);
+size_t vec_mismatch(const void *a, const void *b, size_t n); /* n if equal */
+int vec_is_blank(const void *p, size_t n);
+
 /* Helper macros */
 #define UNUSED(x) (void)(x)
 
@@ -0,0 +1,14 @@
+#ifndef FW_LAYOUT_H
+#define FW_LAYOUT_H
+
+/*
+ * Firmware Image Layout
+ *
+ * Shared by the C code (include/boot.h) and the linker scripts, which the
+ * Makefile preprocesses with it: plain integer defines only. The
+ * application entry point is FW_HEADER_SIZE bytes into the APP partition,
+ * right after fw_header_t; boot.h asserts the struct has this size.
+ */
+#define FW_HEADER_SIZE      128
+
+#endif /* FW_LAYOUT_H */
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""AES-128/256-CTR encryption for encrypted UART updates.
+
+Pure Python (standard library only), matching src/aes.c: the counter block
+is the 12-byte nonce followed by a 32-bit big-endian block index starting
+at 0. The bootloader decrypts with the board's update key
+(keys/dev_aes256.key for QEMU) while the image streams in:
+
+    python3 scripts/aes_ctr.py keys/dev_aes256.key test_app.bin app.enc
+    # prints the nonce; upload app.enc with "SEND <size> <nonce>"
+"""
+import argparse
+import os
+import sys
+
+
+def _build_sbox():
+    sbox = [0] * 256
+    p = q = 1
+    while True:
+        # p walks GF(2^8)* by 3, q by 1/3: q = 1/p
+        p = p ^ ((p << 1) & 0xFF) ^ (0x1B if p & 0x80 else 0)
+        q ^= q << 1
+        q ^= q << 2
+        q ^= q << 4
+        q &= 0xFF
+        if q & 0x80:
+            q ^= 0x09
+        x = q ^ _rotl8(q, 1) ^ _rotl8(q, 2) ^ _rotl8(q, 3) ^ _rotl8(q, 4)
+        sbox[p] = x ^ 0x63
+        if p == 1:
+            break
+    sbox[0] = 0x63
+    return sbox
+
+
+def _rotl8(x, n):
+    return ((x << n) | (x >> (8 - n))) & 0xFF
+
+
+SBOX = _build_sbox()
+
+
+def _xtime(x):
+    return ((x << 1) ^ (0x1B if x & 0x80 else 0)) & 0xFF
+
+
+def expand_key(key):
+    nk = len(key) // 4
+    if len(key) not in (16, 32):
+        raise ValueError("AES key must be 16 or 32 bytes")
+    rounds = nk + 6
+    w = [list(key[4 * i:4 * i + 4]) for i in range(nk)]
+    rcon = 1
+    for i in range(nk, 4 * (rounds + 1)):
+        t = list(w[i - 1])
+        if i % nk == 0:
+            t = [SBOX[b] for b in t[1:] + t[:1]]
+            t[0] ^= rcon
+            rcon = _xtime(rcon)
+        elif nk == 8 and i % nk == 4:
+            t = [SBOX[b] for b in t]
+        w.append([a ^ b for a, b in zip(w[i - nk], t)])
+    return [sum(w[4 * r:4 * r + 4], []) for r in range(rounds + 1)]
+
+
+def encrypt_block(round_keys, block):
+    s = [a ^ b for a, b in zip(block, round_keys[0])]
+    last = len(round_keys) - 1
+    for r in range(1, last + 1):
+        s = [SBOX[b] for b in s]
+        # ShiftRows (state is column-major: s[4 * col + row])
+        s = [s[4 * ((c + row) % 4) + row] for c in range(4) for row in range(4)]
+        if r != last:
+            m = []
+            for c in range(4):
+                a = s[4 * c:4 * c + 4]
+                m += [_xtime(a[i]) ^ _xtime(a[(i + 1) % 4]) ^ a[(i + 1) % 4] ^
+                      a[(i + 2) % 4] ^ a[(i + 3) % 4] for i in range(4)]
+            s = m
+        s = [a ^ b for a, b in zip(s, round_keys[r])]
+    return bytes(s)
+
+
+def ctr_xor(key, nonce, data):
+    """En/decrypt @data with AES-CTR (nonce: 12 bytes)."""
+    if len(nonce) != 12:
+        raise ValueError("nonce must be 12 bytes")
+    rk = expand_key(key)
+    out = bytearray(data)
+    for blk in range(0, len(out), 16):
+        stream = encrypt_block(rk, nonce + (blk // 16).to_bytes(4, "big"))
+        for i in range(min(16, len(out) - blk)):
+            out[blk + i] ^= stream[i]
+    return bytes(out)
+
+
+def load_key(path):
+    with open(path) as f:
+        return bytes.fromhex(f.read().strip())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("key", help="Key file (16 or 32 bytes as hex)")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--nonce", help="12-byte nonce as hex (default: random)")
+    args = parser.parse_args()
+
+    nonce = bytes.fromhex(args.nonce) if args.nonce else os.urandom(12)
+    with open(args.input, "rb") as f:
+        data = f.read()
+    with open(args.output, "wb") as f:
+        f.write(ctr_xor(load_key(args.key), nonce, data))
+    print(nonce.hex())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
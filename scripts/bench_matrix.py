@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""Build the ISA variants for rv32 and rv64 and collect their numbers under QEMU.
+
+For each architecture and each build option set (base, ZKNH, ZKNE, ZBB,
+RVV, ZVBC) the bootloader is built with BENCH=1 and run until BOOT?; the
+BL_EVT:BENCH_* tokens it prints and the flash size of the image are
+collected into one table per architecture:
+
+    SHA256/AES256    cycles per KB, C and scalar-crypto paths
+    CRC32_*          cycles per buffer size, table and Zvbc paths
+    FILL/COPY/...    cycles for the bulk-memory kernels, scalar and RVV
+    flash            bytes stored in FLASH (ZBB=1 shows the code savings)
+
+--boot adds the boot-path numbers from the plain build: a signed image is
+provisioned through fw_cfg and booted twice (SIG_VERIFY_COLD, then
+SIG_VERIFY_WARM after a QMP system_reset), and a padded image is booted
+with and without FW_FLAG_DEFERRED on two harts (HANDOFF_CYCLES,
+APP_VERIFY_DEFERRED). Enter is sent as soon as BOOT? appears, so the
+speculative pre-check has no head start.
+
+Upload times for 1, 4 and 16 MB images come from make bench-update.
+
+Cycle counts are QEMU's (TCG counts instructions, not pipeline cycles):
+compare paths against each other, not against hardware.
+"""
+import argparse
+import os
+import re
+import select
+import shlex
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from ed25519 import load_key  # noqa: E402
+from mkimage import pack  # noqa: E402
+from size_budget import read_sections  # noqa: E402
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+EVT_RE = re.compile(r"BL_EVT:([A-Z0-9_]+):(\d+)")
+
+VARIANTS = (
+    ("base", []),
+    ("zknh", ["ZKNH=1"]),
+    ("zkne", ["ZKNE=1"]),
+    ("zbb", ["ZBB=1"]),
+    ("rvv", ["RVV=1"]),
+    ("zvbc", ["ZVBC=1"]),
+)
+
+BOOT_EVENTS = ("SIG_VERIFY_COLD", "SIG_VERIFY_WARM", "APP_PRECHECK",
+               "HANDOFF_CYCLES", "APP_VERIFY_DEFERRED")
+
+
+def make(options, *targets):
+    """Run make in the repository root; returns its stdout."""
+    cmd = ["make", "-s", "--no-print-directory"] + options + list(targets)
+    return subprocess.run(cmd, cwd=ROOT, check=True, stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout
+
+
+def flash_size(elf):
+    return sum(size for size, in_flash in read_sections(elf).values() if in_flash)
+
+
+class Qemu:
+    """QEMU with the UART on stdio; output is kept for event parsing."""
+
+    def __init__(self, options, extra=()):
+        cmd = shlex.split(make(options, "qemu-cmd").strip())
+        self.proc = subprocess.Popen(cmd + ["-serial", "stdio"] + list(extra), cwd=ROOT,
+                                     stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT, start_new_session=True)
+        self.out = b""
+        self.mark = 0
+
+    def wait_for(self, marker, timeout):
+        """Wait for @marker after the last mark; moves the mark past it."""
+        end = time.time() + timeout
+        while True:
+            pos = self.out.find(marker.encode(), self.mark)
+            if pos >= 0:
+                self.mark = pos + len(marker)
+                return
+            left = end - time.time()
+            if left <= 0:
+                raise TimeoutError(f"no {marker!r} within {timeout} s "
+                                   f"(last output: {self.out[-120:]!r})")
+            ready, _, _ = select.select([self.proc.stdout], [], [], left)
+            if ready:
+                chunk = os.read(self.proc.stdout.fileno(), 4096)
+                if not chunk:
+                    raise RuntimeError(f"QEMU exited (last output: {self.out[-120:]!r})")
+                self.out += chunk
+
+    def send(self, text):
+        self.proc.stdin.write(text.encode())
+        self.proc.stdin.flush()
+
+    def events(self, since=0):
+        text = self.out[since:self.mark].decode(errors="replace")
+        return {name: int(value) for name, value in EVT_RE.findall(text)}
+
+    def close(self):
+        try:
+            os.killpg(self.proc.pid, signal.SIGTERM)
+        except ProcessLookupError:
+            pass
+        self.proc.wait()
+
+
+def qmp(path, command):
+    """Send one QMP command over the monitor socket."""
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+        s.connect(path)
+        s.recv(4096)
+        s.sendall(b'{"execute": "qmp_capabilities"}\n')
+        s.recv(4096)
+        s.sendall(('{"execute": "%s"}\n' % command).encode())
+        s.recv(4096)
+
+
+def bench_kernels(arch, timeout):
+    """{variant: {token: cycles}} for one architecture, plus flash sizes."""
+    rows = {}
+    for name, options in VARIANTS:
+        options = [f"ARCH={arch}", "BENCH=1"] + options
+        make(options, "bootloader.elf")
+        qemu = Qemu(options)
+        try:
+            qemu.wait_for("BOOT?", timeout)
+            row = qemu.events()
+        finally:
+            qemu.close()
+        row["flash"] = flash_size(os.path.join(ROOT, "bootloader.elf"))
+        rows[name] = row
+        print(f"  {arch} {name}: {len(row) - 1} tokens, {row['flash']} bytes flash",
+              file=sys.stderr)
+    return rows
+
+
+def boot_once(options, image, timeout, resets=0):
+    """Provision @image through fw_cfg, boot it (1 + @resets times); merged events."""
+    with tempfile.TemporaryDirectory() as tmp:
+        monitor = os.path.join(tmp, "qmp.sock")
+        qemu = Qemu(options, ["-fw_cfg", f"name=opt/rvbl/app,file={image}",
+                              "-qmp", f"unix:{monitor},server=on,wait=off"])
+        events = {}
+        try:
+            for boot in range(resets + 1):
+                if boot:
+                    qmp(monitor, "system_reset")
+                start = qemu.mark
+                qemu.wait_for("BOOT?", timeout)
+                qemu.send("\n")
+                qemu.wait_for("APP_BOOT", timeout)
+                events.update(qemu.events(start))
+        finally:
+            qemu.close()
+    return events
+
+
+def bench_boot(arch, pad_kb, timeout):
+    """Cold/warm signature verify and deferred-verify handoff for one architecture."""
+    options = [f"ARCH={arch}", "SMP=2"]
+    make(options, "bootloader.elf", "test-app")
+    with open(os.path.join(ROOT, "test_app.bin"), "rb") as f:
+        payload = f.read()
+    padded = payload + b"\xFF" * max(0, pad_kb * 1024 - len(payload))
+    key = load_key(os.path.join(ROOT, "keys", "dev_ed25519.key"))
+    rows = {}
+    with tempfile.TemporaryDirectory() as tmp:
+        runs = (
+            ("signed", pack(payload, key=key), 1),
+            ("padded", pack(padded), 0),
+            ("deferred", pack(padded, deferred=True), 0),
+        )
+        for name, image, resets in runs:
+            path = os.path.join(tmp, f"{name}.img")
+            with open(path, "wb") as f:
+                f.write(image)
+            rows[name] = boot_once(options, path, timeout, resets)
+            print(f"  {arch} boot {name}: {rows[name]}", file=sys.stderr)
+    return rows
+
+
+def table(title, columns, rows, keys):
+    lines = [f"### {title}", "",
+             "| | " + " | ".join(columns) + " |",
+             "|---" * (len(columns) + 1) + "|"]
+    for key in keys:
+        cells = [str(rows[c].get(key, "")) for c in columns]
+        if any(cells):
+            lines.append(f"| {key} | " + " | ".join(cells) + " |")
+    return "\n".join(lines) + "\n"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--arch", nargs="+", default=["rv32", "rv64"], choices=["rv32", "rv64"],
+                        help="Architectures to build (default: rv32 rv64)")
+    parser.add_argument("--boot", action="store_true",
+                        help="Also measure cold/warm verify and the deferred-verify handoff")
+    parser.add_argument("--pad-kb", type=int, default=256,
+                        help="Image size for the deferred-verify runs (default: 256)")
+    parser.add_argument("--timeout", type=float, default=60,
+                        help="Seconds to wait for each QEMU milestone (default: 60)")
+    parser.add_argument("--out", help="Write the Markdown tables here instead of stdout")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    report = []
+    for arch in args.arch:
+        rows = bench_kernels(arch, args.timeout)
+        keys = sorted({k for row in rows.values() for k in row if k != "flash"}) + ["flash"]
+        report.append(table(f"{arch} kernels (BENCH=1)", [n for n, _ in VARIANTS], rows, keys))
+        if args.boot:
+            rows = bench_boot(arch, args.pad_kb, args.timeout)
+            report.append(table(f"{arch} boot path (SMP=2)", list(rows), rows, BOOT_EVENTS))
+    text = "\n".join(report)
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
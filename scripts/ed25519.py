@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Ed25519 signing keys and bootloader key tables.
+
+Pure-Python RFC 8032 Ed25519 (signing only needs the standard library), plus
+the generator for src/ed25519_tables.c: the bootloader verifies against one
+fixed public key, so every multiple of the base point and of the negated
+public key it needs is computed here instead of at boot.
+
+    python3 scripts/ed25519.py keygen keys/my.key
+    python3 scripts/ed25519.py table keys/my.key > src/ed25519_tables.c
+
+Key files hold the 32-byte secret seed as hex. Keep real keys out of the
+repository; keys/dev_ed25519.key is a published development key.
+"""
+import argparse
+import hashlib
+import os
+import sys
+
+P = 2 ** 255 - 19
+L = 2 ** 252 + 27742317777372353535851937790883648493
+D = -121665 * pow(121666, P - 2, P) % P
+SQRT_M1 = pow(2, (P - 1) // 4, P)
+
+WINDOW = 16  # table entries per point: multiples 0..15 (4-bit windows)
+
+
+def _recover_x(y, sign):
+    x2 = (y * y - 1) * pow(D * y * y + 1, P - 2, P) % P
+    x = pow(x2, (P + 3) // 8, P)
+    if (x * x - x2) % P:
+        x = x * SQRT_M1 % P
+    if x & 1 != sign:
+        x = P - x
+    return x
+
+
+_BY = 4 * pow(5, P - 2, P) % P
+BASE = (_recover_x(_BY, 0), _BY, 1, _recover_x(_BY, 0) * _BY % P)
+IDENTITY = (0, 1, 1, 0)
+
+
+def point_add(p, q):
+    """Extended coordinates addition (a = -1 twisted Edwards)."""
+    a = (p[1] - p[0]) * (q[1] - q[0]) % P
+    b = (p[1] + p[0]) * (q[1] + q[0]) % P
+    c = 2 * p[3] * q[3] * D % P
+    d = 2 * p[2] * q[2] % P
+    e, f, g, h = b - a, d - c, d + c, b + a
+    return (e * f % P, g * h % P, f * g % P, e * h % P)
+
+
+def point_mul(s, p):
+    q = IDENTITY
+    while s:
+        if s & 1:
+            q = point_add(q, p)
+        p = point_add(p, p)
+        s >>= 1
+    return q
+
+
+def point_affine(p):
+    zi = pow(p[2], P - 2, P)
+    return p[0] * zi % P, p[1] * zi % P
+
+
+def point_encode(p):
+    x, y = point_affine(p)
+    return (y | ((x & 1) << 255)).to_bytes(32, "little")
+
+
+def point_neg(p):
+    return ((P - p[0]) % P, p[1], p[2], (P - p[3]) % P)
+
+
+def point_decode(b):
+    y = int.from_bytes(b, "little")
+    sign = y >> 255
+    y &= (1 << 255) - 1
+    x = _recover_x(y, sign)
+    return (x, y, 1, x * y % P)
+
+
+def _sha512_int(data):
+    return int.from_bytes(hashlib.sha512(data).digest(), "little")
+
+
+def _expand(seed):
+    h = hashlib.sha512(seed).digest()
+    a = int.from_bytes(h[:32], "little")
+    a &= (1 << 254) - 8
+    a |= 1 << 254
+    return a, h[32:]
+
+
+def public_key(seed):
+    a, _ = _expand(seed)
+    return point_encode(point_mul(a, BASE))
+
+
+def sign(seed, msg):
+    a, prefix = _expand(seed)
+    pub = point_encode(point_mul(a, BASE))
+    r = _sha512_int(prefix + msg) % L
+    rs = point_encode(point_mul(r, BASE))
+    k = _sha512_int(rs + pub + msg) % L
+    s = (r + k * a) % L
+    return rs + s.to_bytes(32, "little")
+
+
+def load_key(path):
+    with open(path) as f:
+        seed = bytes.fromhex(f.read().strip())
+    if len(seed) != 32:
+        raise ValueError(f"{path}: expected 32-byte hex seed")
+    return seed
+
+
+def _fe_limbs(v):
+    """Field element as 16 little-endian 16-bit limbs (the C fe layout)."""
+    return [(v >> (16 * i)) & 0xFFFF for i in range(16)]
+
+
+def _niels_table(p):
+    """Multiples 1..WINDOW-1 of p as (y+x, y-x, 2dxy), affine."""
+    rows = []
+    q = p
+    for _ in range(1, WINDOW):
+        x, y = point_affine(q)
+        rows.append(((y + x) % P, (y - x) % P, 2 * D * x * y % P))
+        q = point_add(q, p)
+    return rows
+
+
+def _emit_table(out, name, rows):
+    out.append(f"const ed25519_niels_t {name}[ED25519_TABLE_SIZE] = {{")
+    for row in rows:
+        out.append("    {")
+        for v in row:
+            limbs = ", ".join(f"0x{x:04x}" for x in _fe_limbs(v))
+            out.append(f"        {{ {limbs} }},")
+        out.append("    },")
+    out.append("};")
+
+
+def table_source(seed, key_path):
+    pub = public_key(seed)
+    neg_a = point_neg(point_decode(pub))
+    out = [
+        '#include "boot.h"',
+        "",
+        "/*",
+        " * Ed25519 Precomputed Tables (generated, do not edit)",
+        " *",
+        f" * Key: {os.path.basename(key_path)}",
+        " * Regenerate with: make keytable SIGN_KEY=<key file>",
+        " *",
+        " * Multiples 1..15 of the base point B and of -A (A = the image signing",
+        " * public key) in affine (y+x, y-x, 2dxy) form, 16-bit limbs.",
+        " */",
+        "",
+        "const uint8_t ed25519_public_key[ED25519_KEY_SIZE] = {",
+    ]
+    for i in range(0, 32, 8):
+        out.append("    " + ", ".join(f"0x{b:02x}" for b in pub[i:i + 8]) + ",")
+    out.append("};")
+    out.append("")
+    _emit_table(out, "ed25519_base_table", _niels_table(BASE))
+    out.append("")
+    _emit_table(out, "ed25519_key_table", _niels_table(neg_a))
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    p = sub.add_parser("keygen", help="Write a new random key file")
+    p.add_argument("key")
+    p = sub.add_parser("table", help="Print src/ed25519_tables.c for a key")
+    p.add_argument("key")
+    p = sub.add_parser("pubkey", help="Print the public key (hex)")
+    p.add_argument("key")
+    args = parser.parse_args()
+
+    if args.cmd == "keygen":
+        if os.path.exists(args.key):
+            print(f"error: {args.key} exists", file=sys.stderr)
+            return 1
+        with open(args.key, "w") as f:
+            f.write(os.urandom(32).hex() + "\n")
+        return 0
+
+    seed = load_key(args.key)
+    if args.cmd == "table":
+        sys.stdout.write(table_source(seed, args.key))
+    else:
+        print(public_key(seed).hex())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
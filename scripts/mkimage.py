@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Pack a raw application binary into a fw_header_t image.
+
+The packed layout matches include/boot.h:
+
+    uint32_t magic    "RVBL" (0x5256424C), little-endian
+    uint32_t size     payload size in bytes
+    uint32_t crc32    CRC32 (IEEE 802.3) of the payload
+    uint32_t version  firmware version
+    uint32_t flags    FW_FLAG_SHA256 (bit 0): sha256 field is valid
+                      FW_FLAG_DEFERRED (bit 2): app may start before the
+                      payload check ends (unsigned images only, see below)
+    uint32_t reserved[3]
+    uint8_t  sha256[32] SHA-256 of the payload
+    uint8_t  signature[64] Ed25519 signature of sha256 (FW_FLAG_SIGNED, bit 1)
+    payload
+
+Packed images can be installed from any image source (block device, ...);
+the bootloader checks the CRC (and the digest, when flagged) before
+committing the header, and the signature (when flagged) before booting.
+
+A --deferred image starts while the worker hart is still checking its
+payload, so it must:
+
+  - run in place and never modify its own partition
+  - keep out of the bootloader's RAM below RAM_BASE + BOOT_RAM_SIZE
+    (boards/<BOARD>/board.h; linker/test_app.ld does this)
+  - tolerate a reset at any point: on a mismatch the worker notes the image
+    in RAM and resets at once, without touching the flash controller, and
+    the next boot stores the failure in the boot state and stays in recovery
+"""
+import argparse
+import struct
+import sys
+from binascii import crc32
+from hashlib import sha256
+
+import ed25519
+
+BOOT_MAGIC = 0x5256424C
+FW_FLAG_SHA256 = 1 << 0
+FW_FLAG_SIGNED = 1 << 1
+FW_FLAG_DEFERRED = 1 << 2
+HEADER_FORMAT = "<IIIII12x32s64s"
+SECTOR_SIZE = 512
+
+
+def pack(payload, version=1, digest=True, key=None, deferred=False):
+    """Return header + payload bytes; @key (Ed25519 seed) signs the digest."""
+    if key is not None and not digest:
+        raise ValueError("signing requires the SHA-256 digest")
+    if key is not None and deferred:
+        raise ValueError("signed images are always verified before boot")
+    flags = FW_FLAG_SHA256 if digest else 0
+    if deferred:
+        flags |= FW_FLAG_DEFERRED
+    sha = sha256(payload).digest() if digest else bytes(32)
+    signature = bytes(64)
+    if key is not None:
+        flags |= FW_FLAG_SIGNED
+        signature = ed25519.sign(key, sha)
+    header = struct.pack(HEADER_FORMAT, BOOT_MAGIC, len(payload),
+                         crc32(payload) & 0xFFFFFFFF, version, flags, sha, signature)
+    return header + payload
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="Raw application binary (e.g. test_app.bin)")
+    parser.add_argument("output", help="Packed image to write")
+    parser.add_argument("--version", type=lambda v: int(v, 0), default=1,
+                        help="Firmware version stored in the header (default: 1)")
+    parser.add_argument("--no-sha256", action="store_true",
+                        help="Leave the SHA-256 digest out (CRC32 check only)")
+    parser.add_argument("--sign", metavar="KEY",
+                        help="Sign the digest with an Ed25519 key file (scripts/ed25519.py)")
+    parser.add_argument("--deferred", action="store_true",
+                        help="Let the app start before its payload check ends (worker hart)")
+    parser.add_argument("--pad-sector", action="store_true",
+                        help="Pad output to a whole number of 512-byte sectors (disk images)")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    with open(args.input, "rb") as f:
+        payload = f.read()
+    if not payload:
+        print(f"error: {args.input} is empty", file=sys.stderr)
+        return 1
+
+    key = ed25519.load_key(args.sign) if args.sign else None
+    try:
+        image = pack(payload, args.version, digest=not args.no_sha256, key=key,
+                     deferred=args.deferred)
+    except ValueError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    if args.pad_sector and len(image) % SECTOR_SIZE:
+        image += b"\xff" * (SECTOR_SIZE - len(image) % SECTOR_SIZE)
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print(f"{args.output}: {len(payload)} byte payload, crc32=0x{crc32(payload) & 0xFFFFFFFF:08X}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""Report worst-case stack depth per entry point and the RAM budget.
+
+Reads the per-function frame sizes (*.su, GCC -fstack-usage) and call
+graphs (*.ci, GCC -fcallgraph-info) from an object tree, then walks the
+graph from each entry point:
+
+    main         hart 0, on the main stack (_stack_bottom .. _stack_top)
+    worker_main  update worker hart, on .worker_stack
+
+Results are upper bounds for direct calls only. Paths through function
+pointers (transport callbacks, flash completion callbacks, image sources)
+are flagged, as are recursion and dynamically sized frames; assembly
+routines (start.S, semihost.S) count as zero. The runtime counterpart is
+BL_EVT:STAT_STACK_PEAK (stack painting in start.S).
+
+With --elf, the linker symbols give the RAM layout and each entry's stack
+budget; the exit status is 1 if a worst case does not fit.
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ENTRIES = (
+    ("main", "_stack_bottom", "_stack_top"),
+    ("worker_main", "_worker_stack_bottom", "_worker_stack_top"),
+)
+
+# (label, start symbol, end symbol) in RAM order
+RAM_LAYOUT = (
+    (".ramfunc", "_data_start", "_ramfunc_end"),
+    (".data", "_ramfunc_end", "_data_end"),
+    (".bss", "_bss_start", "_bss_end"),
+    (".noinit", "_noinit_start", "_noinit_end"),
+    ("worker stack", "_worker_stack_bottom", "_worker_stack_top"),
+    ("main stack", "_stack_bottom", "_stack_top"),
+    ("arena", "_arena_start", "_arena_end"),
+)
+
+INDIRECT = "__indirect_call"
+
+NODE_RE = re.compile(r'node:\s*\{\s*title:\s*"([^"]*)"\s*label:\s*"([^"]*)"(.*)\}')
+EDGE_RE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]*)"\s*targetname:\s*"([^"]*)"')
+SU_RE = re.compile(r'^(.*):\d+:\d+:(\S+)\t(\d+)\t(\S+)$')
+
+
+class Function:
+    def __init__(self, name, unit):
+        self.name = name
+        self.unit = unit
+        self.frame = 0
+        self.qualifier = "static"
+        self.callees = []
+        self.indirect = False
+
+
+def load_tree(root):
+    """Parse every .ci/.su pair below @root; return defined functions."""
+    units = {}      # unit -> {name: Function}
+    for dirpath, _, files in os.walk(root):
+        for name in sorted(files):
+            path = os.path.join(dirpath, name)
+            if name.endswith(".ci"):
+                parse_ci(path, units.setdefault(os.path.splitext(path)[0], {}))
+            elif name.endswith(".su"):
+                parse_su(path, units.setdefault(os.path.splitext(path)[0], {}))
+    return units
+
+
+def bare(title):
+    # Static functions are titled "<file>:<name>" in the call graph
+    return title.rsplit(":", 1)[-1]
+
+
+def parse_ci(path, funcs):
+    with open(path) as f:
+        text = f.read()
+    for title, label, rest in NODE_RE.findall(text):
+        title = bare(title)
+        # Declared-only callees are drawn as ellipses: not defined here
+        if "ellipse" in rest or title == INDIRECT:
+            continue
+        func = funcs.setdefault(title, Function(title, path))
+        m = re.search(r"(\d+) bytes \((\w[\w,]*)\)", label)
+        if m:
+            func.frame = int(m.group(1))
+            func.qualifier = m.group(2)
+    for source, target in EDGE_RE.findall(text):
+        source, target = bare(source), bare(target)
+        func = funcs.setdefault(source, Function(source, path))
+        if target == INDIRECT:
+            func.indirect = True
+        elif target not in func.callees:
+            func.callees.append(target)
+
+
+def parse_su(path, funcs):
+    with open(path) as f:
+        for line in f:
+            m = SU_RE.match(line.rstrip("\n"))
+            if not m:
+                continue
+            func = funcs.setdefault(m.group(2), Function(m.group(2), path))
+            func.frame = int(m.group(3))
+            func.qualifier = m.group(4)
+
+
+class Graph:
+    def __init__(self, units):
+        self.units = units
+        self.globals = {}
+        for funcs in units.values():
+            for name, func in funcs.items():
+                self.globals.setdefault(name, func)
+        self.memo = {}
+        self.unknown = set()
+
+    def resolve(self, name, unit):
+        # Static functions shadow same-named ones in other units
+        local = self.units.get(os.path.splitext(unit)[0], {})
+        if name in local:
+            return local[name]
+        func = self.globals.get(name)
+        if func is None:
+            self.unknown.add(name)
+        return func
+
+    def worst(self, func, active=()):
+        """(bytes, path, flags) of the deepest call chain below @func."""
+        key = id(func)
+        if key in self.memo:
+            return self.memo[key]
+        if key in active:
+            return 0, [func.name + " (recursion)"], {"recursion"}
+        active = active + (key,)
+
+        flags = set()
+        if func.indirect:
+            flags.add("indirect")
+        if func.qualifier != "static":
+            flags.add(func.qualifier)
+        best, best_path = 0, []
+        for name in func.callees:
+            callee = self.resolve(name, func.unit)
+            if callee is None:
+                continue
+            depth, path, sub = self.worst(callee, active)
+            flags |= sub
+            if depth > best:
+                best, best_path = depth, path
+        result = (func.frame + best, [func.name] + best_path, flags)
+        if "recursion" not in flags:
+            self.memo[key] = result
+        return result
+
+    def indirect_callers(self, func, seen=None):
+        """Functions reachable from @func that call through a pointer."""
+        seen = set() if seen is None else seen
+        if id(func) in seen:
+            return []
+        seen.add(id(func))
+        out = [func.name] if func.indirect else []
+        for name in func.callees:
+            callee = self.resolve(name, func.unit)
+            if callee is not None:
+                out += self.indirect_callers(callee, seen)
+        return out
+
+
+def read_symbols(nm, elf):
+    out = subprocess.run([nm, elf], check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3:
+            symbols[parts[2]] = int(parts[0], 16)
+    return symbols
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("objdir", help="Object tree built with -fstack-usage -fcallgraph-info=su")
+    parser.add_argument("--elf", help="Linked bootloader ELF (RAM layout and stack budgets)")
+    parser.add_argument("--nm", default="nm", help="nm for the target (default: nm)")
+    parser.add_argument("--top", type=int, default=10,
+                        help="Number of largest frames to list (default: 10)")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    units = load_tree(args.objdir)
+    if not units:
+        print(f"error: no .su/.ci files under {args.objdir}", file=sys.stderr)
+        return 1
+    graph = Graph(units)
+    symbols = read_symbols(args.nm, args.elf) if args.elf else {}
+
+    status = 0
+    print("Worst-case stack per entry point (direct calls):")
+    for entry, lo, hi in ENTRIES:
+        func = graph.globals.get(entry)
+        if func is None:
+            print(f"  {entry:<12} not found")
+            continue
+        depth, path, flags = graph.worst(func)
+        line = f"  {entry:<12} {depth:>6} B"
+        if lo in symbols and hi in symbols:
+            budget = symbols[hi] - symbols[lo]
+            line += f" of {budget} B"
+            if depth > budget:
+                line += "  OVER BUDGET"
+                status = 1
+        if flags:
+            line += "  [" + ", ".join(sorted(flags)) + "]"
+        print(line)
+        print("    " + " > ".join(path))
+        callers = graph.indirect_callers(func)
+        if callers:
+            print("    + calls through pointers in: " + ", ".join(sorted(set(callers))))
+
+    frames = sorted((f for funcs in units.values() for f in funcs.values()),
+                    key=lambda f: f.frame, reverse=True)[:args.top]
+    print("\nLargest frames:")
+    for func in frames:
+        note = "" if func.qualifier == "static" else f" ({func.qualifier})"
+        print(f"  {func.frame:>6} B  {func.name}{note}")
+
+    if graph.unknown:
+        print("\nNo frame data (assembly or library): " + ", ".join(sorted(graph.unknown)))
+
+    if symbols:
+        print("\nRAM layout:")
+        for label, lo, hi in RAM_LAYOUT:
+            if lo in symbols and hi in symbols:
+                print(f"  {label:<13} 0x{symbols[lo]:08X}  {symbols[hi] - symbols[lo]:>7} B")
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
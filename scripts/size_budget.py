@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Check bootloader code size against the checked-in budget.
+
+Reads section sizes from the ELF section headers and symbol sizes from
+`nm -S`, then compares them with the budget file:
+
+    limit <flash|section> <bytes>   hard limit, exit status 1 above it
+    config <build>                  build the baseline was taken from
+    section <name> <bytes>          baseline section size
+    symbol <name> <bytes>           baseline symbol size (flash-resident)
+
+"flash" is everything the image stores in the FLASH region: all allocated
+sections that are not NOBITS (.text, .rodata and the .data load image).
+The report lists section sizes, the largest symbols and the top growers
+against the baseline; --table writes the full per-symbol table and
+--update replaces the baseline with the current build (limits are kept).
+Without a baseline the limits are still enforced; the report says the
+growers list is missing.
+"""
+import argparse
+import struct
+import subprocess
+import sys
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# nm types stored in flash: code, read-only data, initialized data
+FLASH_TYPES = "tTrRdDgGsS"
+
+
+def read_sections(path):
+    """{name: (size, in_flash)} for allocated sections of an ELF file."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        raise ValueError(f"{path}: not an ELF file")
+    wide = elf[4] == 2
+    if wide:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        fmt = "<IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        fmt = "<IIIIIIIIII"
+
+    headers = [struct.unpack_from(fmt, elf, shoff + i * shentsize) for i in range(shnum)]
+    strtab = headers[shstrndx][4]
+
+    sections = {}
+    for name_off, sh_type, flags, _, _, size, *_ in headers:
+        if not flags & SHF_ALLOC or size == 0:
+            continue
+        end = elf.index(b"\0", strtab + name_off)
+        name = elf[strtab + name_off:end].decode()
+        sections[name] = (size, sh_type != SHT_NOBITS)
+    return sections
+
+
+def read_symbols(nm, path):
+    """{name: size} of sized, flash-resident symbols (same-named statics summed)."""
+    out = subprocess.run([nm, "-S", path], check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) != 4 or parts[2] not in FLASH_TYPES:
+            continue
+        symbols[parts[3]] = symbols.get(parts[3], 0) + int(parts[1], 16)
+    return symbols
+
+
+def read_budget(path):
+    budget = {"limit": {}, "section": {}, "symbol": {}, "config": None, "header": []}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                if not budget["section"] and not budget["symbol"]:
+                    budget["header"].append(line.rstrip("\n"))
+                continue
+            if fields[0] == "config":
+                budget["config"] = fields[1]
+            elif fields[0] in ("limit", "section", "symbol") and len(fields) == 3:
+                budget[fields[0]][fields[1]] = int(fields[2], 0)
+            else:
+                raise ValueError(f"{path}: bad line: {line.strip()}")
+    return budget
+
+
+def write_budget(path, budget, config, sections, symbols):
+    lines = list(budget["header"])
+    lines += [f"limit {name} {value}" for name, value in budget["limit"].items()]
+    lines += ["", "# Baseline (make size-baseline)", f"config {config}"]
+    lines += [f"section {name} {size}" for name, (size, _) in sorted(sections.items())]
+    lines += [f"symbol {name} {size}"
+              for name, size in sorted(symbols.items(), key=lambda s: (-s[1], s[0]))]
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def write_table(path, sections, symbols, flash):
+    with open(path, "w") as f:
+        f.write(f"flash {flash}\n")
+        for name, (size, in_flash) in sorted(sections.items()):
+            f.write(f"section {name} {size}{'' if in_flash else ' (ram)'}\n")
+        for name, size in sorted(symbols.items(), key=lambda s: (-s[1], s[0])):
+            f.write(f"symbol {name} {size}\n")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="Linked bootloader (bootloader.elf)")
+    parser.add_argument("budget", help="Budget file (scripts/size_budget.txt)")
+    parser.add_argument("--nm", default="nm", help="nm for the target (default: nm)")
+    parser.add_argument("--config", default="", help="Build configuration name")
+    parser.add_argument("--table", help="Write the full section/symbol table here")
+    parser.add_argument("--top", type=int, default=10,
+                        help="Number of symbols per list (default: 10)")
+    parser.add_argument("--update", action="store_true",
+                        help="Replace the baseline with this build")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    sections = read_sections(args.elf)
+    symbols = read_symbols(args.nm, args.elf)
+    budget = read_budget(args.budget)
+    flash = sum(size for size, in_flash in sections.values() if in_flash)
+
+    if args.table:
+        write_table(args.table, sections, symbols, flash)
+    if args.update:
+        write_budget(args.budget, budget, args.config, sections, symbols)
+        print(f"{args.budget}: baseline updated ({args.config}, flash {flash} B)")
+        return 0
+
+    compare = bool(budget["symbol"])
+    if compare and budget["config"] != args.config:
+        print(f"note: baseline is for {budget['config']}, this build is {args.config}")
+
+    status = 0
+    print("Sections:")
+    for name, (size, in_flash) in sorted(sections.items()):
+        line = f"  {name:<20} {size:>7} B"
+        if not in_flash:
+            line += "  (ram)"
+        elif compare and name in budget["section"]:
+            line += f"  {size - budget['section'][name]:+d}"
+        print(line)
+
+    print("\nLimits:")
+    usage = {"flash": flash}
+    usage.update((name, size) for name, (size, _) in sections.items())
+    for name, limit in budget["limit"].items():
+        used = usage.get(name, 0)
+        verdict = "OK" if used <= limit else "OVER"
+        print(f"  {name:<20} {used:>7} / {limit} B  ({limit - used:+d} headroom)  {verdict}")
+        if used > limit:
+            status = 1
+
+    print("\nLargest symbols:")
+    for name, size in sorted(symbols.items(), key=lambda s: -s[1])[:args.top]:
+        print(f"  {size:>7} B  {name}")
+
+    if compare:
+        deltas = {name: size - budget["symbol"].get(name, 0) for name, size in symbols.items()}
+        for name, size in budget["symbol"].items():
+            if name not in symbols:
+                deltas[name] = -size
+        growers = sorted((d for d in deltas.items() if d[1] > 0), key=lambda d: -d[1])
+        total = sum(deltas.values())
+        print(f"\nTop growers since baseline ({total:+d} B over all symbols):")
+        if not growers:
+            print("  none")
+        for name, delta in growers[:args.top]:
+            tag = "  (new)" if name not in budget["symbol"] else ""
+            print(f"  {delta:>+7} B  {name}{tag}")
+    else:
+        # Only the hard limits guard this build: a regression below them
+        # goes unnoticed until a baseline is committed
+        print("\nwarning: no baseline in the budget file, so no growers list: "
+              "run make size-baseline on the default build and commit it")
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
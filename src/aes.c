@@ -0,0 +1,226 @@
+#include "boot.h"
+
+/*
+ * AES-128/256 Encryption and CTR Mode
+ *
+ * CTR only ever runs the cipher forwards, so there is no decryption
+ * direction. State columns are little-endian words, the layout the RV32
+ * scalar crypto instructions use, so both round backends share one body:
+ * - table: one 1 KB SubBytes+MixColumns table (te0) built from the S-box
+ *   on first use, the other three byte lanes by rotation
+ * - Zkne: aes32esmi/aes32esi, built when the compiler targets RV32 Zkne
+ *   (-march=rv32..._zkne, see ZKNE=1 in the Makefile)
+ * aes_ctr_xor() uses the fastest one available.
+ */
+
+static const uint8_t aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/* te0[x] = MixColumns column of SubBytes(x) in row 0: (2s, s, s, 3s) */
+static uint32_t aes_te0[256];
+static int aes_te0_ready;
+
+static inline uint32_t rol32(uint32_t x, unsigned n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+static inline uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void aes_build_te0(void) {
+    for (int x = 0; x < 256; x++) {
+        uint32_t s = aes_sbox[x];
+        uint32_t s2 = ((s << 1) ^ ((s & 0x80) ? 0x1B : 0)) & 0xFF;
+        aes_te0[x] = s2 | (s << 8) | (s << 16) | ((s2 ^ s) << 24);
+    }
+    aes_te0_ready = 1;
+}
+
+static inline uint32_t sub_word(uint32_t w) {
+    return (uint32_t)aes_sbox[w & 0xFF] | ((uint32_t)aes_sbox[(w >> 8) & 0xFF] << 8) |
+           ((uint32_t)aes_sbox[(w >> 16) & 0xFF] << 16) | ((uint32_t)aes_sbox[w >> 24] << 24);
+}
+
+/*
+ * One output column: rk ^ f(byte 0 of a) ^ f(byte 1 of b) ^ ... where f is
+ * SubBytes+MixColumns (@last = 0) or SubBytes alone (@last = 1), each
+ * contribution rotated into its byte lane. @zk is a compile-time constant
+ * at every call site.
+ */
+#if defined(AES_ZKNE)
+#define ZK_ESMI(acc, x, bs) __asm__ ("aes32esmi %0, %0, %1, " #bs : "+r"(acc) : "r"(x))
+#define ZK_ESI(acc, x, bs)  __asm__ ("aes32esi %0, %0, %1, " #bs : "+r"(acc) : "r"(x))
+#endif
+
+static inline __attribute__((always_inline))
+uint32_t aes_column(uint32_t rk, uint32_t a, uint32_t b, uint32_t c, uint32_t d, int last, int zk) {
+#if defined(AES_ZKNE)
+    if (zk) {
+        if (last) {
+            ZK_ESI(rk, a, 0); ZK_ESI(rk, b, 1); ZK_ESI(rk, c, 2); ZK_ESI(rk, d, 3);
+        } else {
+            ZK_ESMI(rk, a, 0); ZK_ESMI(rk, b, 1); ZK_ESMI(rk, c, 2); ZK_ESMI(rk, d, 3);
+        }
+        return rk;
+    }
+#endif
+    (void)zk;
+    if (last) {
+        return rk ^ (uint32_t)aes_sbox[a & 0xFF] ^ ((uint32_t)aes_sbox[(b >> 8) & 0xFF] << 8) ^
+               ((uint32_t)aes_sbox[(c >> 16) & 0xFF] << 16) ^ ((uint32_t)aes_sbox[d >> 24] << 24);
+    }
+    return rk ^ aes_te0[a & 0xFF] ^ rol32(aes_te0[(b >> 8) & 0xFF], 8) ^
+           rol32(aes_te0[(c >> 16) & 0xFF], 16) ^ rol32(aes_te0[d >> 24], 24);
+}
+
+static inline __attribute__((always_inline))
+void aes_rounds(const aes_ctx_t *ctx, const uint8_t in[AES_BLOCK_SIZE],
+                uint8_t out[AES_BLOCK_SIZE], int zk) {
+    const uint32_t *rk = ctx->rk;
+    uint32_t s0 = load_le32(in) ^ rk[0];
+    uint32_t s1 = load_le32(in + 4) ^ rk[1];
+    uint32_t s2 = load_le32(in + 8) ^ rk[2];
+    uint32_t s3 = load_le32(in + 12) ^ rk[3];
+
+    /* ShiftRows: row r of column j comes from column j + r */
+    for (uint32_t r = 1; r < ctx->rounds; r++) {
+        rk += 4;
+        uint32_t t0 = aes_column(rk[0], s0, s1, s2, s3, 0, zk);
+        uint32_t t1 = aes_column(rk[1], s1, s2, s3, s0, 0, zk);
+        uint32_t t2 = aes_column(rk[2], s2, s3, s0, s1, 0, zk);
+        uint32_t t3 = aes_column(rk[3], s3, s0, s1, s2, 0, zk);
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    rk += 4;
+    store_le32(out, aes_column(rk[0], s0, s1, s2, s3, 1, zk));
+    store_le32(out + 4, aes_column(rk[1], s1, s2, s3, s0, 1, zk));
+    store_le32(out + 8, aes_column(rk[2], s2, s3, s0, s1, 1, zk));
+    store_le32(out + 12, aes_column(rk[3], s3, s0, s1, s2, 1, zk));
+}
+
+void aes_encrypt_block_c(const aes_ctx_t *ctx, const uint8_t in[AES_BLOCK_SIZE],
+                         uint8_t out[AES_BLOCK_SIZE]) {
+    aes_rounds(ctx, in, out, 0);
+}
+
+#if defined(AES_ZKNE)
+void aes_encrypt_block_zkne(const aes_ctx_t *ctx, const uint8_t in[AES_BLOCK_SIZE],
+                            uint8_t out[AES_BLOCK_SIZE]) {
+    aes_rounds(ctx, in, out, 1);
+}
+#define aes_encrypt_block aes_encrypt_block_zkne
+#else
+#define aes_encrypt_block aes_encrypt_block_c
+#endif
+
+int aes_init(aes_ctx_t *ctx, const uint8_t *key, size_t key_len) {
+    uint32_t nk;
+    if (key_len == 16) {
+        nk = 4;
+        ctx->rounds = 10;
+    } else if (key_len == 32) {
+        nk = 8;
+        ctx->rounds = 14;
+    } else {
+        return -1;
+    }
+    if (!aes_te0_ready) {
+        aes_build_te0();
+    }
+
+    /* FIPS 197 key expansion; RotWord on a little-endian word is ror 8 */
+    uint32_t *w = ctx->rk;
+    uint32_t total = 4 * (ctx->rounds + 1);
+    uint32_t rcon = 0x01;
+    for (uint32_t i = 0; i < nk; i++) {
+        w[i] = load_le32(key + 4 * i);
+    }
+    for (uint32_t i = nk; i < total; i++) {
+        uint32_t t = w[i - 1];
+        if (i % nk == 0) {
+            t = sub_word(rol32(t, 24)) ^ rcon;
+            rcon = ((rcon << 1) ^ ((rcon & 0x80) ? 0x1B : 0)) & 0xFF;
+        } else if (nk == 8 && i % nk == 4) {
+            t = sub_word(t);
+        }
+        w[i] = w[i - nk] ^ t;
+    }
+    return 0;
+}
+
+int aes_ctr_init(aes_ctr_t *ctr, const uint8_t *key, size_t key_len,
+                 const uint8_t nonce[AES_CTR_NONCE_SIZE]) {
+    if (aes_init(&ctr->aes, key, key_len) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < AES_CTR_NONCE_SIZE; i++) {
+        ctr->counter[i] = nonce[i];
+    }
+    for (int i = AES_CTR_NONCE_SIZE; i < AES_BLOCK_SIZE; i++) {
+        ctr->counter[i] = 0;
+    }
+    ctr->used = AES_BLOCK_SIZE;
+    return 0;
+}
+
+/* Next keystream block; the low 32 bits of the counter are big-endian */
+static void aes_ctr_refill(aes_ctr_t *ctr) {
+    aes_encrypt_block(&ctr->aes, ctr->counter, ctr->stream);
+    for (int i = AES_BLOCK_SIZE - 1; i >= AES_CTR_NONCE_SIZE; i--) {
+        if (++ctr->counter[i] != 0) {
+            break;
+        }
+    }
+    ctr->used = 0;
+}
+
+void aes_ctr_xor(aes_ctr_t *ctr, uint8_t *data, size_t len) {
+    /* Finish a partly used keystream block */
+    while (len && ctr->used < AES_BLOCK_SIZE) {
+        *data++ ^= ctr->stream[ctr->used++];
+        len--;
+    }
+
+    /* Whole blocks */
+    while (len >= AES_BLOCK_SIZE) {
+        aes_ctr_refill(ctr);
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            data[i] ^= ctr->stream[i];
+        }
+        ctr->used = AES_BLOCK_SIZE;
+        data += AES_BLOCK_SIZE;
+        len -= AES_BLOCK_SIZE;
+    }
+
+    if (len) {
+        aes_ctr_refill(ctr);
+        while (len--) {
+            *data++ ^= ctr->stream[ctr->used++];
+        }
+    }
+}
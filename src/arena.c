@@ -0,0 +1,53 @@
+#include "boot.h"
+
+/*
+ * Scratch Arena
+ *
+ * A bump allocator over the linker's ARENA region (linker/memory.ld).
+ * Boot phases that never overlap (update receive, image install,
+ * benchmarks) reuse the same bytes: each phase takes a mark,
+ * allocates, and releases back to the mark when done. The deepest fill
+ * seen is kept as boot_stats.arena_peak to size the region.
+ *
+ * ARENA sits at the top of the linked RAM, so when the device tree reports
+ * more RAM (QEMU -m) arena_grow() simply moves the end up.
+ */
+
+extern uint8_t _arena_start[];
+extern uint8_t _arena_end[];
+
+static size_t arena_used;
+static uint8_t *arena_end = _arena_end;     /* Moved up by arena_grow() */
+
+void *arena_alloc(size_t size) {
+    size_t avail = (size_t)(arena_end - _arena_start) - arena_used;
+    if (size > avail || ((size + 7) & ~(size_t)7) > avail) {
+        return NULL;
+    }
+    size = (size + 7) & ~(size_t)7;
+
+    void *p = _arena_start + arena_used;
+    arena_used += size;
+    if (arena_used > boot_stats.arena_peak) {
+        boot_stats.arena_peak = (uint32_t)arena_used;
+    }
+    return p;
+}
+
+size_t arena_mark(void) {
+    return arena_used;
+}
+
+void arena_release(size_t mark) {
+    if (mark <= arena_used) {
+        arena_used = mark;
+    }
+}
+
+size_t arena_grow(uintptr_t end) {
+    end &= ~(uintptr_t)7;
+    if (end > (uintptr_t)arena_end) {
+        arena_end = (uint8_t *)end;
+    }
+    return (size_t)(arena_end - _arena_start);
+}
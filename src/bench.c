@@ -0,0 +1,149 @@
+#include "boot.h"
+
+/*
+ * Boot-time Kernel Benchmarks (BENCH=1 builds only)
+ *
+ * Each kernel is timed with mcycle over BENCH_LEN bytes of the APP region
+ * (read-only, so the installed image is never disturbed; write kernels
+ * target a RAM scratch buffer) and reported as
+ *   BL_EVT:BENCH_<KERNEL>:<cycles per KB>
+ * Absolute numbers are only meaningful on hardware; under QEMU TCG mcycle
+ * tracks instructions retired, which still ranks the backends.
+ */
+
+#ifdef CONFIG_BENCH
+
+#define BENCH_LEN   (16 * 1024)
+
+static const uint8_t *bench_data(void) {
+    return (const uint8_t *)(uintptr_t)APP_BASE;
+}
+
+static void bench_report(const char *token, uint32_t cycles) {
+    emit_bl_evt_u32(token, cycles / (BENCH_LEN / 1024));
+}
+
+static void bench_sha256(const char *token, void (*compress)(uint32_t *, const uint8_t *)) {
+    uint32_t state[8] = { 0 };
+    const uint8_t *p = bench_data();
+
+    uint32_t start = cycle_count();
+    for (uint32_t off = 0; off < BENCH_LEN; off += SHA256_BLOCK_SIZE) {
+        compress(state, p + off);
+    }
+    bench_report(token, cycle_count() - start);
+}
+
+static void bench_aes(const char *token,
+                      void (*encrypt)(const aes_ctx_t *, const uint8_t *, uint8_t *)) {
+    static const uint8_t key[32] = { 0 };
+    aes_ctx_t ctx;
+    uint8_t out[AES_BLOCK_SIZE];
+    const uint8_t *p = bench_data();
+
+    aes_init(&ctx, key, sizeof(key));
+    uint32_t start = cycle_count();
+    for (uint32_t off = 0; off < BENCH_LEN; off += AES_BLOCK_SIZE) {
+        encrypt(&ctx, p + off, out);
+    }
+    bench_report(token, cycle_count() - start);
+}
+
+/* CRC32 across image sizes from 1 KB up to the default 448 KB partition,
+ * plus multi-MB sizes on layouts large enough for them (make APP_MB=) */
+static const struct {
+    const char *token_c;
+    const char *token_zvbc;
+    uint32_t kb;
+} bench_crc_sizes[] = {
+    { "BENCH_CRC32_C_1K",   "BENCH_CRC32_ZVBC_1K",   1 },
+    { "BENCH_CRC32_C_16K",  "BENCH_CRC32_ZVBC_16K",  16 },
+    { "BENCH_CRC32_C_64K",  "BENCH_CRC32_ZVBC_64K",  64 },
+    { "BENCH_CRC32_C_448K", "BENCH_CRC32_ZVBC_448K", 448 },
+#if APP_MAX_SIZE >= 16 * 1024 * 1024
+    { "BENCH_CRC32_C_4M",   "BENCH_CRC32_ZVBC_4M",   4 * 1024 },
+    { "BENCH_CRC32_C_16M",  "BENCH_CRC32_ZVBC_16M",  16 * 1024 },
+#endif
+};
+
+static void bench_crc32(int zvbc) {
+    for (size_t i = 0; i < sizeof(bench_crc_sizes) / sizeof(bench_crc_sizes[0]); i++) {
+        uint32_t kb = bench_crc_sizes[i].kb;
+        uint32_t start = cycle_count();
+#if defined(CRC32_ZVBC)
+        if (zvbc) {
+            (void)crc32_update_zvbc(0, bench_data(), kb * 1024);
+        } else
+#endif
+        {
+            (void)crc32_update_c(0, bench_data(), kb * 1024);
+        }
+        uint32_t cycles = cycle_count() - start;
+        emit_bl_evt_u32(zvbc ? bench_crc_sizes[i].token_zvbc : bench_crc_sizes[i].token_c,
+                        cycles / kb);
+    }
+}
+
+typedef void *(*bench_fill_fn)(void *, int, size_t);
+typedef void *(*bench_copy_fn)(void *, const void *, size_t);
+typedef int (*bench_cmp_fn)(const void *, const void *, size_t);
+typedef int (*bench_blank_fn)(const void *, size_t);
+
+/* Bulk-memory kernels: fill, blank check, copy, compare */
+static void bench_mem(uint8_t *bench_buf, const char *fill_token, bench_fill_fn fill,
+                      const char *copy_token, bench_copy_fn copy,
+                      const char *cmp_token, bench_cmp_fn cmp,
+                      const char *blank_token, bench_blank_fn blank) {
+    uint32_t start;
+
+    start = cycle_count();
+    fill(bench_buf, 0xFF, BENCH_LEN);
+    bench_report(fill_token, cycle_count() - start);
+
+    /* Blank check over a buffer that is blank end to end (worst case) */
+    start = cycle_count();
+    (void)blank(bench_buf, BENCH_LEN);
+    bench_report(blank_token, cycle_count() - start);
+
+    start = cycle_count();
+    copy(bench_buf, bench_data(), BENCH_LEN);
+    bench_report(copy_token, cycle_count() - start);
+
+    /* Equal buffers: compare runs the full length (read-back verify case) */
+    start = cycle_count();
+    (void)cmp(bench_buf, bench_data(), BENCH_LEN);
+    bench_report(cmp_token, cycle_count() - start);
+}
+
+void bench_run(void) {
+    bench_sha256("BENCH_SHA256_C", sha256_compress_c);
+#if defined(__riscv_zknh)
+    bench_sha256("BENCH_SHA256_ZKNH", sha256_compress_zknh);
+#endif
+    /* AES-256 block cipher: CTR decryption costs the same per byte */
+    bench_aes("BENCH_AES256_C", aes_encrypt_block_c);
+#if defined(AES_ZKNE)
+    bench_aes("BENCH_AES256_ZKNE", aes_encrypt_block_zkne);
+#endif
+    bench_crc32(0);
+#if defined(CRC32_ZVBC)
+    bench_crc32(1);
+#endif
+
+    /* Memory kernels need a scratch buffer: borrowed from the arena */
+    size_t mark = arena_mark();
+    uint8_t *buf = arena_alloc(BENCH_LEN);
+    if (!buf) {
+        return;
+    }
+    bench_mem(buf, "BENCH_FILL_SCALAR", memset_scalar, "BENCH_COPY_SCALAR", memcpy_scalar,
+              "BENCH_CMP_SCALAR", memcmp_scalar, "BENCH_BLANK_SCALAR", mem_is_blank_scalar);
+#ifdef CONFIG_RVV
+    /* The public primitives dispatch to src/vec.c at this size */
+    bench_mem(buf, "BENCH_FILL_RVV", memset, "BENCH_COPY_RVV", memcpy,
+              "BENCH_CMP_RVV", memcmp, "BENCH_BLANK_RVV", mem_is_blank);
+#endif
+    arena_release(mark);
+}
+
+#endif /* CONFIG_BENCH */
@@ -0,0 +1,429 @@
+#include "boot.h"
+
+/*
+ * Ed25519 Signature Verification (RFC 8032)
+ *
+ * Verification only, against the single image signing key built into the
+ * bootloader. Instead of decompressing the key and computing its multiples
+ * at boot, scripts/ed25519.py precomputes 1..15 times B and -A
+ * (src/ed25519_tables.c), so checking [S]B - [k]A == R is one shared run of
+ * 252 doublings with 4-bit window additions and no table setup.
+ *
+ * Field elements are 16 limbs of 16 bits (int32 storage, int64 products):
+ * every multiply is a 32x32->64 widening multiply, which RV32IM does
+ * natively. Only public data is processed, so nothing here needs to be
+ * constant time.
+ */
+
+typedef int32_t fe[16];
+
+typedef struct {
+    fe x, y, z, t;      /* extended coordinates: x = X/Z, y = Y/Z, xy = T/Z */
+} ge_t;
+
+/*----------------------------------------------------------------------------
+ * Field arithmetic mod 2^255 - 19
+ *--------------------------------------------------------------------------*/
+
+/* Propagate carries; the top carry wraps to limb 0 times 38 (2^256 = 38) */
+static void fe_carry(int64_t o[16]) {
+    for (int i = 0; i < 16; i++) {
+        o[i] += 1 << 16;
+        int64_t c = o[i] >> 16;
+        if (i < 15) {
+            o[i + 1] += c - 1;
+        } else {
+            o[0] += 38 * (c - 1);
+        }
+        o[i] -= c * 65536;
+    }
+}
+
+static void fe_0(fe o) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = 0;
+    }
+}
+
+static void fe_1(fe o) {
+    fe_0(o);
+    o[0] = 1;
+}
+
+static void fe_load(fe o, const uint16_t limbs[16]) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = limbs[i];
+    }
+}
+
+static void fe_add(fe o, const fe a, const fe b) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] + b[i];
+    }
+}
+
+static void fe_sub(fe o, const fe a, const fe b) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] - b[i];
+    }
+}
+
+static void fe_mul(fe o, const fe a, const fe b) {
+    int64_t t[31];
+    for (int i = 0; i < 31; i++) {
+        t[i] = 0;
+    }
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            t[i + j] += (int64_t)a[i] * b[j];
+        }
+    }
+    for (int i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    fe_carry(t);
+    fe_carry(t);
+    for (int i = 0; i < 16; i++) {
+        o[i] = (int32_t)t[i];
+    }
+}
+
+static void fe_sq(fe o, const fe a) {
+    fe_mul(o, a, a);
+}
+
+/* a^(p-2) = 1/a */
+static void fe_inv(fe o, const fe a) {
+    fe c;
+    for (int i = 0; i < 16; i++) {
+        c[i] = a[i];
+    }
+    for (int i = 253; i >= 0; i--) {
+        fe_sq(c, c);
+        if (i != 2 && i != 4) {
+            fe_mul(c, c, a);
+        }
+    }
+    for (int i = 0; i < 16; i++) {
+        o[i] = c[i];
+    }
+}
+
+/* Fully reduce and serialize (32 bytes, little-endian) */
+static void fe_pack(uint8_t out[32], const fe a) {
+    int64_t t[16], m[16];
+    for (int i = 0; i < 16; i++) {
+        t[i] = a[i];
+    }
+    fe_carry(t);
+    fe_carry(t);
+    fe_carry(t);
+
+    /* Subtract p at most twice, keeping the non-negative result */
+    for (int pass = 0; pass < 2; pass++) {
+        m[0] = t[0] - 0xffed;
+        for (int i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xffff;
+        }
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        int borrow = (int)((m[15] >> 16) & 1);
+        m[14] &= 0xffff;
+        if (!borrow) {
+            for (int i = 0; i < 16; i++) {
+                t[i] = m[i];
+            }
+        }
+    }
+
+    for (int i = 0; i < 16; i++) {
+        out[2 * i] = (uint8_t)t[i];
+        out[2 * i + 1] = (uint8_t)(t[i] >> 8);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Group operations (twisted Edwards, a = -1)
+ *--------------------------------------------------------------------------*/
+
+static void ge_identity(ge_t *p) {
+    fe_0(p->x);
+    fe_1(p->y);
+    fe_1(p->z);
+    fe_0(p->t);
+}
+
+/* p = 2p */
+static void ge_double(ge_t *p) {
+    fe xx, yy, b, aa, x3, y3, z3, t3;
+
+    fe_sq(xx, p->x);
+    fe_sq(yy, p->y);
+    fe_sq(b, p->z);
+    fe_add(b, b, b);
+    fe_add(aa, p->x, p->y);
+    fe_sq(aa, aa);
+
+    fe_add(y3, yy, xx);
+    fe_sub(z3, yy, xx);
+    fe_sub(x3, aa, y3);
+    fe_sub(t3, b, z3);
+
+    fe_mul(p->x, x3, t3);
+    fe_mul(p->y, y3, z3);
+    fe_mul(p->z, z3, t3);
+    fe_mul(p->t, x3, y3);
+}
+
+/* p += q, q affine from a precomputed table */
+static void ge_madd(ge_t *p, const ed25519_niels_t *q) {
+    fe a, b, c, d, e, f, g, h, n;
+
+    fe_sub(a, p->y, p->x);
+    fe_load(n, q->ymx);
+    fe_mul(a, a, n);
+    fe_add(b, p->y, p->x);
+    fe_load(n, q->ypx);
+    fe_mul(b, b, n);
+    fe_load(n, q->xy2d);
+    fe_mul(c, p->t, n);
+    fe_add(d, p->z, p->z);
+
+    fe_sub(e, b, a);
+    fe_sub(f, d, c);
+    fe_add(g, d, c);
+    fe_add(h, b, a);
+
+    fe_mul(p->x, e, f);
+    fe_mul(p->y, g, h);
+    fe_mul(p->z, f, g);
+    fe_mul(p->t, e, h);
+}
+
+static void ge_pack(uint8_t out[32], const ge_t *p) {
+    fe zi, x, y;
+    uint8_t xb[32];
+
+    fe_inv(zi, p->z);
+    fe_mul(x, p->x, zi);
+    fe_mul(y, p->y, zi);
+    fe_pack(out, y);
+    fe_pack(xb, x);
+    out[31] ^= (uint8_t)((xb[0] & 1) << 7);
+}
+
+/*----------------------------------------------------------------------------
+ * Scalars mod L = 2^252 + 27742317777372353535851937790883648493
+ *--------------------------------------------------------------------------*/
+
+static const uint8_t ed25519_l[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10
+};
+
+/* r = x mod L for a 64-byte little-endian x held one byte per element */
+static void sc_reduce(uint8_t r[32], int64_t x[64]) {
+    int64_t carry;
+    int j;
+
+    for (int i = 63; i >= 32; i--) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; j++) {
+            x[j] += carry - 16 * x[i] * ed25519_l[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * ed25519_l[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * ed25519_l[j];
+    }
+    for (int i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+/* Canonical encoding check: s < L */
+static int sc_is_canonical(const uint8_t s[32]) {
+    for (int i = 31; i >= 0; i--) {
+        if (s[i] < ed25519_l[i]) {
+            return 1;
+        }
+        if (s[i] > ed25519_l[i]) {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+static unsigned sc_nibble(const uint8_t s[32], int i) {
+    return (s[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+}
+
+/*----------------------------------------------------------------------------
+ * SHA-512 (only for k = H(R || A || M), so a one-shot form is enough)
+ *--------------------------------------------------------------------------*/
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+/* Constant shift counts only: these expand inline on RV32 (no libgcc) */
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static void sha512_block(uint64_t s[8], const uint8_t *block) {
+    uint64_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint64_t)load_be32(block + 8 * i) << 32) | load_be32(block + 8 * i + 4);
+    }
+    for (int i = 16; i < 80; i++) {
+        uint64_t s0 = ROTR64(w[i - 15], 1) ^ ROTR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        uint64_t s1 = ROTR64(w[i - 2], 19) ^ ROTR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = s[0], b = s[1], c = s[2], d = s[3];
+    uint64_t e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int i = 0; i < 80; i++) {
+        uint64_t t1 = h + (ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41)) +
+                      ((e & f) ^ (~e & g)) + sha512_k[i] + w[i];
+        uint64_t t2 = (ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39)) +
+                      ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    s[0] += a; s[1] += b; s[2] += c; s[3] += d;
+    s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+}
+
+/* One-shot SHA-512 of the concatenation of up to three parts */
+static void sha512_3(uint8_t out[64], const uint8_t *p1, size_t n1,
+                     const uint8_t *p2, size_t n2, const uint8_t *p3, size_t n3) {
+    static const uint64_t iv[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+    const uint8_t *part[3] = { p1, p2, p3 };
+    size_t len[3] = { n1, n2, n3 };
+    uint64_t s[8];
+    uint8_t buf[128];
+    size_t fill = 0;
+    uint32_t total = 0;
+
+    for (int i = 0; i < 8; i++) {
+        s[i] = iv[i];
+    }
+    for (int k = 0; k < 3; k++) {
+        for (size_t i = 0; i < len[k]; i++) {
+            buf[fill++] = part[k][i];
+            if (fill == sizeof(buf)) {
+                sha512_block(s, buf);
+                fill = 0;
+            }
+        }
+        total += (uint32_t)len[k];
+    }
+
+    /* 0x80, zero pad, 128-bit big-endian bit length (messages are tiny) */
+    buf[fill++] = 0x80;
+    if (fill > sizeof(buf) - 16) {
+        while (fill < sizeof(buf)) {
+            buf[fill++] = 0;
+        }
+        sha512_block(s, buf);
+        fill = 0;
+    }
+    while (fill < sizeof(buf) - 4) {
+        buf[fill++] = 0;
+    }
+    uint32_t bits = total << 3;
+    buf[124] = (uint8_t)(bits >> 24);
+    buf[125] = (uint8_t)(bits >> 16);
+    buf[126] = (uint8_t)(bits >> 8);
+    buf[127] = (uint8_t)bits;
+    sha512_block(s, buf);
+
+    for (int i = 0; i < 8; i++) {
+        uint32_t hi = (uint32_t)(s[i] >> 32);
+        uint32_t lo = (uint32_t)s[i];
+        for (int j = 0; j < 4; j++) {
+            out[8 * i + j] = (uint8_t)(hi >> (24 - 8 * j));
+            out[8 * i + 4 + j] = (uint8_t)(lo >> (24 - 8 * j));
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Verification
+ *--------------------------------------------------------------------------*/
+
+int ed25519_verify(const uint8_t sig[ED25519_SIG_SIZE], const uint8_t *msg, size_t len) {
+    const uint8_t *r = sig;
+    const uint8_t *s = sig + 32;
+
+    if (!sc_is_canonical(s)) {
+        return -1;
+    }
+
+    /* k = H(R || A || M) mod L */
+    uint8_t h[64], k[32];
+    int64_t x[64];
+    sha512_3(h, r, 32, ed25519_public_key, ED25519_KEY_SIZE, msg, len);
+    for (int i = 0; i < 64; i++) {
+        x[i] = h[i];
+    }
+    sc_reduce(k, x);
+
+    /* [S]B + [k](-A), both scalars walked together 4 bits at a time */
+    ge_t p;
+    ge_identity(&p);
+    for (int i = 63; i >= 0; i--) {
+        if (i != 63) {
+            ge_double(&p);
+            ge_double(&p);
+            ge_double(&p);
+            ge_double(&p);
+        }
+        unsigned ns = sc_nibble(s, i);
+        unsigned nk = sc_nibble(k, i);
+        if (ns) {
+            ge_madd(&p, &ed25519_base_table[ns - 1]);
+        }
+        if (nk) {
+            ge_madd(&p, &ed25519_key_table[nk - 1]);
+        }
+    }
+
+    uint8_t check[32];
+    ge_pack(check, &p);
+    return (memcmp(check, r, 32) == 0) ? 0 : -1;
+}
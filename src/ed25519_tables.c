@@ -0,0 +1,174 @@
+#include "boot.h"
+
+/*
+ * Ed25519 Precomputed Tables (generated, do not edit)
+ *
+ * Key: dev_ed25519.key
+ * Regenerate with: make keytable SIGN_KEY=<key file>
+ *
+ * Multiples 1..15 of the base point B and of -A (A = the image signing
+ * public key) in affine (y+x, y-x, 2dxy) form, 16-bit limbs.
+ */
+
+const uint8_t ed25519_public_key[ED25519_KEY_SIZE] = {
+    0xf7, 0x84, 0xe4, 0x9e, 0x55, 0x44, 0xd4, 0xb5,
+    0xce, 0x26, 0xba, 0xfc, 0xcd, 0x46, 0x06, 0x8e,
+    0x9e, 0x64, 0xef, 0x10, 0x70, 0x17, 0x27, 0x1d,
+    0x5a, 0x45, 0x29, 0x85, 0x4d, 0x52, 0x47, 0xd1,
+};
+
+const ed25519_niels_t ed25519_base_table[ED25519_TABLE_SIZE] = {
+    {
+        { 0x3b85, 0xf58c, 0x93c6, 0x2fbc, 0x0e19, 0xfb8c, 0x2dc6, 0xcf93, 0x42c2, 0x643d, 0x4898, 0x270b, 0xba65, 0x33d4, 0x9d3a, 0x07cf },
+        { 0x913e, 0xd740, 0x3905, 0x9d10, 0xbeb3, 0xd140, 0x9f05, 0xfd39, 0x8a09, 0x688f, 0x8434, 0xa5c1, 0x1267, 0x98f8, 0x2f92, 0x44fd },
+        { 0xaa68, 0x877a, 0x1205, 0xabc9, 0xc49e, 0xccaa, 0xe823, 0x26d9, 0x598c, 0xdd43, 0x7dcb, 0x5a1b, 0x65a8, 0x9f0c, 0x7b68, 0x6f11 },
+    },
+    {
+        { 0x71d7, 0x933c, 0xe7fc, 0x9224, 0xf5b5, 0x7a0f, 0x9d96, 0x9f46, 0x0702, 0xe1d6, 0x9a65, 0x5aa6, 0x2e2e, 0xa87d, 0x063f, 0x590c },
+        { 0xd5a8, 0x42b4, 0xa560, 0x8a99, 0xacf6, 0x4e60, 0x810c, 0x8f2b, 0x37aa, 0xb16e, 0x236b, 0xe09e, 0x2555, 0x69c9, 0x95a6, 0x6bb5 },
+        { 0x7a5f, 0xa59b, 0xa8b3, 0x43fa, 0xcf78, 0x5d9a, 0x6bdd, 0x36c1, 0x6a31, 0x0b3d, 0xa084, 0x500f, 0x0b73, 0x3ea5, 0xf5b1, 0x701a },
+    },
+    {
+        { 0x9730, 0x4cee, 0xb0a8, 0xaf25, 0x4b8a, 0xe886, 0x8430, 0x025a, 0x6732, 0x9f01, 0x5002, 0xc11b, 0xf8f4, 0x9a80, 0x4e1b, 0x7a16 },
+        { 0xd265, 0xa4fc, 0x1fe8, 0x5661, 0xba7d, 0xe5c1, 0x53fd, 0x3bd3, 0xd6bd, 0x214b, 0xf31a, 0x8131, 0xda62, 0x555b, 0x1587, 0x2ab9 },
+        { 0xd889, 0x0dd0, 0x933f, 0x14ae, 0xda62, 0x1c35, 0x2322, 0x5894, 0xdb4c, 0x8cf2, 0xe545, 0xd170, 0xb4c6, 0x12b9, 0x26af, 0x5a28 },
+    },
+    {
+        { 0x099f, 0x8efc, 0x51b9, 0x2873, 0x2538, 0x7dfd, 0xc6f4, 0x6765, 0x9265, 0xfb0a, 0x8d3d, 0xca34, 0x8727, 0x21e5, 0x9103, 0x680e },
+        { 0x18bf, 0x0568, 0x050a, 0x95fe, 0xfaa9, 0x5660, 0x8971, 0x327e, 0x5073, 0x06a0, 0xe3cd, 0xc3e8, 0xa49a, 0x7445, 0x3f4c, 0x2793 },
+        { 0xff09, 0xc476, 0xfbe9, 0x5a13, 0xc172, 0x7b5c, 0x3945, 0x6e9e, 0x4494, 0x102b, 0xdcf9, 0x5ddb, 0x3e2b, 0x6355, 0x0cbf, 0x7f9d },
+    },
+    {
+        { 0xbb33, 0x08a5, 0xbc44, 0xa212, 0xed02, 0xc75e, 0x48c3, 0x8d50, 0xec44, 0x5abf, 0xeb0c, 0xdd1b, 0x06eb, 0x46e2, 0xccf1, 0x2945 },
+        { 0xd6ba, 0xa447, 0x82c3, 0x7f91, 0x29b7, 0x4b27, 0x14d1, 0xd500, 0xa087, 0xb864, 0xf11c, 0xe33c, 0x55f3, 0xeb1b, 0x7e73, 0x154a },
+        { 0x8285, 0x812a, 0xdbf1, 0xbcbb, 0xd1fc, 0xd0bd, 0x0807, 0x270e, 0xa72d, 0x1bbd, 0x670b, 0xb41b, 0xb69a, 0x6b3b, 0xbe69, 0x43aa },
+    },
+    {
+        { 0x7131, 0x7715, 0xeeeb, 0x3a0c, 0xaf88, 0x00c8, 0x1589, 0x9b27, 0xa736, 0xda59, 0xb668, 0x8065, 0x38bd, 0xa2cc, 0x7bb6, 0x51e5 },
+        { 0x8ca4, 0x7b7d, 0x06b6, 0x4998, 0x2739, 0x27d2, 0xe284, 0x575b, 0x53b9, 0x2045, 0x5ce7, 0xbb08, 0x7884, 0xae41, 0x4c41, 0x38b6 },
+        { 0x4b71, 0x02ea, 0x3267, 0x85ac, 0xbb01, 0x41a1, 0xe003, 0xbe70, 0xc144, 0x083b, 0xa24b, 0x53e4, 0x61e3, 0x9f0d, 0xe91a, 0x10b8 },
+    },
+    {
+        { 0xa3bf, 0x944e, 0x5cd0, 0x6b1a, 0xc0d2, 0xb39d, 0x353a, 0x7470, 0x2e49, 0x2854, 0x5282, 0x71b2, 0x927e, 0x283c, 0xea69, 0x461b },
+        { 0x21b1, 0xaa32, 0x2c9a, 0xba6f, 0x23a7, 0x3bba, 0x2153, 0x6ca0, 0x2c3a, 0x9219, 0x764f, 0x9dea, 0x17e0, 0x2e53, 0xdd5d, 0x1d6e },
+        { 0xb3a2, 0x01b8, 0x6dc8, 0xf183, 0xa49a, 0x053e, 0x5f47, 0xb303, 0xadf3, 0x5877, 0x41ba, 0x529c, 0x90a7, 0x6a0f, 0xbb1c, 0x7a9f },
+    },
+    {
+        { 0x3e8f, 0x04dd, 0x5966, 0x59b7, 0x702c, 0xe288, 0x0377, 0x6cb3, 0xc323, 0x5ed9, 0x9c66, 0xb133, 0xe52f, 0x61bc, 0xe760, 0x0915 },
+        { 0x34d9, 0xf392, 0x5ded, 0xe2a7, 0x58f9, 0xe1b5, 0x7680, 0x963d, 0x23fb, 0x6e3c, 0x41ac, 0x2c27, 0x01c3, 0x320e, 0x24a1, 0x3a90 },
+        { 0x911a, 0xc9a2, 0xf5d9, 0xe7c1, 0xa7d7, 0x8bcc, 0x7178, 0xb8a3, 0x2a32, 0x0eb6, 0x1219, 0x6364, 0x4e95, 0x2ecc, 0x7c5c, 0x2690 },
+    },
+    {
+        { 0x632f, 0xa6a8, 0x678a, 0x9b2e, 0x46c5, 0x51bc, 0x9e6f, 0xa650, 0xf5b5, 0xc686, 0x33c9, 0xceb2, 0x7f59, 0x8add, 0xed33, 0x34b9 },
+        { 0x8064, 0x039d, 0x217e, 0xf36e, 0x419b, 0xf520, 0x81b6, 0x98a0, 0xb044, 0xe75e, 0xc608, 0x96cb, 0x9c8f, 0xfadc, 0x5a51, 0x49c0 },
+        { 0xaf1b, 0x9045, 0xe8bf, 0x06b4, 0xd22f, 0xa719, 0x83e8, 0xe2ff, 0xcf16, 0x93d4, 0xfc29, 0xaaf6, 0x8b06, 0x1b00, 0x7202, 0x73c1 },
+    },
+    {
+        { 0x748e, 0xb360, 0x93d2, 0xff1d, 0xe057, 0x1617, 0x34d4, 0x45f5, 0x4646, 0x9b55, 0x0363, 0x0d55, 0x91ed, 0xaae5, 0x7628, 0x43ac },
+        { 0x81dd, 0x2270, 0x558e, 0x75f3, 0xf02f, 0x65a9, 0x1836, 0x04f8, 0x3958, 0xf5dc, 0x9745, 0x8473, 0xb702, 0x4950, 0x832c, 0x0353 },
+        { 0xf8d8, 0x03d0, 0x2ae4, 0xd03d, 0x6340, 0xd3f0, 0x1ccb, 0x1d0c, 0xb509, 0x6731, 0x9f0f, 0xff16, 0x4ce7, 0x70bf, 0x2af4, 0x0ec6 },
+    },
+    {
+        { 0x2ade, 0x8a80, 0x0084, 0x2fbf, 0x2e27, 0x0230, 0xfecf, 0xe5d9, 0x3406, 0x1770, 0x8471, 0x113e, 0x8faf, 0x546d, 0xaae2, 0x4275 },
+        { 0x4348, 0x4986, 0x5b02, 0x315f, 0x8381, 0x7708, 0xb369, 0x3ed6, 0xeb95, 0x6a8d, 0x7555, 0xa3a0, 0xc77f, 0x29d5, 0x5980, 0x18ab },
+        { 0x89e9, 0xfd60, 0x2cc5, 0xd82b, 0xe4a4, 0x3282, 0xb4a1, 0x031e, 0x8622, 0xb51a, 0x1199, 0x4431, 0xf948, 0xb53d, 0x5522, 0x3dc6 },
+    },
+    {
+        { 0x7539, 0xa71e, 0x8042, 0xe235, 0xd1a9, 0xd834, 0x3dd7, 0x88de, 0x6f93, 0x701a, 0xdd2e, 0x45ec, 0xdd58, 0x8d3c, 0xafde, 0x078a },
+        { 0x54b9, 0xb53d, 0x8375, 0x856f, 0x5b24, 0xccb2, 0xbf90, 0x23b2, 0xdbdd, 0x56d5, 0xfb6e, 0x884d, 0x22ed, 0x8a60, 0xece2, 0x7956 },
+        { 0x4553, 0x7f94, 0x94d8, 0xeea5, 0x180b, 0xa24e, 0xda23, 0xf66c, 0x6461, 0xf497, 0x589a, 0xffcb, 0xd0c6, 0x1c83, 0xa515, 0x37c6 },
+    },
+    {
+        { 0x7f6d, 0xa200, 0xc222, 0xbf70, 0xdedb, 0xb5bc, 0xb39a, 0xbf84, 0xba07, 0xfb07, 0x0e12, 0x537a, 0xf241, 0xc346, 0xd7ee, 0x234f },
+        { 0xbf93, 0x327f, 0x013b, 0x506f, 0x6f6b, 0x9b77, 0xebc9, 0xaefc, 0x5968, 0xaaad, 0xb232, 0x9d12, 0x24a7, 0x1760, 0x882d, 0x0267 },
+        { 0xa378, 0x732e, 0xa119, 0x5360, 0xd471, 0xdf8d, 0xe6b1, 0x2437, 0xe533, 0x91a7, 0x37f8, 0xa2ef, 0x7863, 0xaa09, 0xa6fd, 0x497b },
+    },
+    {
+        { 0x3df2, 0x3f21, 0x70ec, 0x26f8, 0xa987, 0x57ef, 0x7fc0, 0x8027, 0xbdd5, 0x2881, 0x4c04, 0x1a47, 0x1630, 0x464d, 0x60b2, 0x6eaf },
+        { 0x1280, 0xd417, 0x8a44, 0xdfdb, 0xa331, 0xdb7c, 0xb20f, 0xce69, 0x47a9, 0x6eec, 0x56f1, 0x112e, 0x80d2, 0x5b3c, 0xea2c, 0x2df0 },
+        { 0x1b82, 0x7a1e, 0xc587, 0x96a1, 0xbf54, 0xa2a9, 0x97ed, 0xf023, 0x1baa, 0x3ecb, 0xdf70, 0x9c1f, 0x9c93, 0xd8ba, 0x7e3c, 0x24bf },
+    },
+    {
+        { 0xeaa0, 0x13cf, 0xcc03, 0x24ce, 0x246d, 0x189c, 0xc28d, 0x8648, 0xd4d0, 0xc1f2, 0xbdfa, 0x2dbd, 0xe72b, 0xf12d, 0x2917, 0x61e2 },
+        { 0xcf0b, 0x468c, 0xcd86, 0x040b, 0x10d6, 0x2a99, 0x9ba4, 0xd382, 0x5192, 0x07b2, 0x3008, 0x7508, 0x5ebf, 0x18d0, 0xcd42, 0x43b5 },
+        { 0xb516, 0x9bd0, 0x762f, 0x5d9a, 0xdeee, 0x373f, 0xaf4e, 0xeb38, 0x4270, 0x93d6, 0x5a7d, 0x032e, 0xd842, 0x0ae4, 0x6121, 0x511d },
+    },
+};
+
+const ed25519_niels_t ed25519_key_table[ED25519_TABLE_SIZE] = {
+    {
+        { 0x9041, 0x9462, 0x0b4a, 0x9c52, 0x984c, 0xb819, 0xf282, 0x5d6b, 0x1940, 0x7f63, 0xead3, 0x37d2, 0xbeef, 0x1541, 0x3177, 0x5f3f },
+        { 0x79ad, 0xa966, 0x7d60, 0xcf56, 0xb550, 0x415a, 0x9b19, 0xbea0, 0xaffc, 0xa27b, 0x440c, 0x027b, 0xcbc5, 0xf510, 0x7323, 0x434f },
+        { 0xb1c9, 0x4420, 0x5c9f, 0x3879, 0x2cc5, 0x6771, 0xd74f, 0x0e04, 0x8acb, 0x3c7c, 0x30bb, 0x8a42, 0x0a99, 0xba40, 0x060c, 0x7452 },
+    },
+    {
+        { 0xa8c1, 0x929e, 0x9a13, 0xa677, 0x0b29, 0x11ff, 0xa81e, 0x00d1, 0x1132, 0x8ca9, 0x7141, 0x8763, 0x2581, 0x19eb, 0xe66f, 0x31df },
+        { 0xe085, 0xf230, 0xd7bd, 0xf296, 0x6def, 0x6882, 0x2504, 0xa123, 0xca70, 0xdb46, 0x8eb8, 0x68a7, 0xa4b0, 0x4c0c, 0x40c4, 0x5288 },
+        { 0x9e1d, 0x63cc, 0x34e1, 0xca6e, 0x895d, 0xa60c, 0x4058, 0xae1c, 0x3bf5, 0x34cb, 0xedfe, 0x2ecf, 0x050a, 0xbabd, 0x4c0e, 0x7cd2 },
+    },
+    {
+        { 0x9a78, 0x5e99, 0x15f2, 0x35e6, 0xf9b1, 0x68c8, 0x28e3, 0x062a, 0x5127, 0xfed7, 0x37f9, 0xe588, 0xd204, 0x8efd, 0xbf52, 0x1fae },
+        { 0xa0f7, 0x0791, 0xb10c, 0x7524, 0x5c78, 0xc62e, 0x6a4e, 0x77f2, 0x3eaf, 0x1f2e, 0xf040, 0xcb1e, 0xca2a, 0xdbf7, 0xd753, 0x3194 },
+        { 0x238c, 0x2077, 0x99da, 0xa624, 0x5c3e, 0x9f39, 0x0c6b, 0x9913, 0x4292, 0xe826, 0x1889, 0xe821, 0x49e6, 0x7db4, 0x07a5, 0x2ab2 },
+    },
+    {
+        { 0x0d8f, 0x1cf5, 0xb8e5, 0xed25, 0x502d, 0xa7a1, 0xb688, 0x47ea, 0x7acd, 0x46c3, 0x087c, 0x148f, 0x04e4, 0xeee2, 0xcd65, 0x451f },
+        { 0xc128, 0x3051, 0x44d3, 0x1c39, 0x9dd3, 0x2b86, 0x2188, 0x8003, 0x17b1, 0xde63, 0x47ad, 0xab5e, 0xbf9f, 0x51b8, 0x14bc, 0x526f },
+        { 0x9e66, 0x31b9, 0x7740, 0x5604, 0x9372, 0x6078, 0xe90a, 0x25ac, 0xe19f, 0x8f0e, 0x178f, 0x8f53, 0x06f2, 0x3c05, 0xb7b1, 0x0391 },
+    },
+    {
+        { 0xfa3b, 0x1ab0, 0xeceb, 0x47c7, 0x61c7, 0x9954, 0x0af4, 0xab43, 0x4113, 0x7838, 0x03fe, 0xaceb, 0x9579, 0x2a4e, 0x1d5d, 0x0b13 },
+        { 0x25fb, 0xc1e7, 0x435c, 0xa6d8, 0xdeab, 0xcc3a, 0x43ea, 0x847c, 0x6932, 0xd93e, 0x1263, 0x9db3, 0x49f9, 0xed75, 0x37ed, 0x3f3a },
+        { 0x2edb, 0xfc65, 0x3adc, 0x37c4, 0x3d64, 0xa7a7, 0x04b7, 0xc96a, 0x2ca0, 0x0254, 0x51b2, 0x637c, 0x2599, 0xc516, 0x25c1, 0x0bef },
+    },
+    {
+        { 0x17b1, 0x8ee2, 0x009d, 0xd8b8, 0x2191, 0xb6b8, 0x5582, 0x8927, 0x15bb, 0x723e, 0x7213, 0xd105, 0x9831, 0x5288, 0xb92d, 0x613b },
+        { 0x7556, 0x28cf, 0xfda3, 0xebc6, 0x490a, 0x0eed, 0x699f, 0xe0f1, 0x288f, 0xc304, 0x982b, 0xc2d2, 0xffb3, 0x90af, 0xd86a, 0x72aa },
+        { 0x6402, 0xbcb7, 0x7f8f, 0x243c, 0xbb64, 0xf10f, 0xfda5, 0x102d, 0xf039, 0xc7a0, 0xc915, 0xd56a, 0xe45d, 0xb357, 0xb9e1, 0x2e36 },
+    },
+    {
+        { 0xbfbe, 0x765f, 0xedd0, 0xb794, 0x3364, 0x2c4f, 0x6857, 0x5f2a, 0x85a7, 0x5496, 0x0281, 0x4f93, 0x9be3, 0x3c7e, 0x6558, 0x6245 },
+        { 0x131a, 0x6735, 0x177e, 0xca45, 0x7335, 0xa82f, 0x3b3e, 0x9a22, 0x0edf, 0xc5f0, 0x0274, 0x05c3, 0xed44, 0x1a85, 0x473c, 0x13dd },
+        { 0x49e8, 0xffb6, 0x11a6, 0xb91e, 0x7576, 0xa109, 0xca5c, 0x07dd, 0x717a, 0x5b48, 0x5885, 0x4d1d, 0xa626, 0x2a17, 0x1bac, 0x54cf },
+    },
+    {
+        { 0xba3a, 0x84de, 0x6589, 0x8119, 0x6750, 0x7518, 0xb7fb, 0xb49a, 0x5ffc, 0xa370, 0x7140, 0xcf26, 0x24ec, 0x13ff, 0xbc4b, 0x0161 },
+        { 0x002a, 0xd919, 0xfc51, 0x757b, 0x725f, 0x9a57, 0x715c, 0x2759, 0xd2b8, 0x6c99, 0x57cf, 0x96e3, 0x3904, 0x2c7a, 0x169a, 0x7e1b },
+        { 0x925c, 0xe98f, 0x224b, 0xfa27, 0x6c07, 0xfb8c, 0xc753, 0x5c35, 0xf2e9, 0xa398, 0x9796, 0xc9f6, 0x7888, 0x6fb8, 0x0c6d, 0x2fc4 },
+    },
+    {
+        { 0x729a, 0x70c8, 0xd41c, 0x8213, 0x21a4, 0xa6b1, 0x7b9d, 0xbf6e, 0xa435, 0x6998, 0x1363, 0x042d, 0xe303, 0x6888, 0xbfeb, 0x0455 },
+        { 0x5f13, 0x4e57, 0x1ef6, 0xee45, 0x3372, 0xb572, 0xcd40, 0x2cc0, 0x8f7d, 0xe8ad, 0xa6c6, 0x7a72, 0x950c, 0x4a64, 0x93ed, 0x66f3 },
+        { 0xffc8, 0x0049, 0xebe0, 0xf652, 0xd4f9, 0x7688, 0x4b4c, 0x56a8, 0x7d23, 0x8cdc, 0x9fde, 0x2424, 0xf365, 0x86da, 0x5b45, 0x78c4 },
+    },
+    {
+        { 0x847d, 0x6ff1, 0xb9b2, 0xb167, 0x36c0, 0x3b52, 0x5b51, 0xb1f4, 0xeadd, 0x955b, 0x035a, 0x7921, 0x4f0b, 0x2aa9, 0xc8d5, 0x1ee7 },
+        { 0xebaf, 0x209d, 0x7568, 0x65ba, 0xae41, 0x79f4, 0x944f, 0x5e73, 0x9b57, 0xcd48, 0x9a29, 0x2072, 0x378d, 0xaed7, 0x63f7, 0x409f },
+        { 0xe754, 0xc6f0, 0x7ee8, 0xeb36, 0x0ee2, 0xb2d3, 0xf666, 0xbc40, 0x967c, 0x7f56, 0x4957, 0x6189, 0x1a71, 0x4292, 0x4fac, 0x0237 },
+    },
+    {
+        { 0xb95c, 0xa498, 0xb21c, 0x390d, 0x92bc, 0xb4c4, 0xdff8, 0x6b47, 0xb446, 0x6b7d, 0xaa56, 0xb594, 0x5487, 0xb467, 0x9da4, 0x7a1e },
+        { 0x17de, 0x264b, 0x2822, 0xf92d, 0x1f2e, 0xd880, 0xd538, 0x83a8, 0x0839, 0x18c2, 0x24d9, 0x13ce, 0xa73f, 0x44d2, 0x54bb, 0x1d01 },
+        { 0x0f81, 0x661f, 0xa645, 0xa6c5, 0xbf8d, 0x656f, 0x25b5, 0xdc77, 0x6e33, 0x85b3, 0xbfde, 0x0357, 0x0e83, 0x4472, 0xc5cd, 0x7863 },
+    },
+    {
+        { 0x14ac, 0xf03b, 0xe3f1, 0xad35, 0x42c2, 0xf24a, 0xb116, 0x3ceb, 0x6119, 0x6c2c, 0xdf14, 0xfcef, 0x0c48, 0xe148, 0x0053, 0x030c },
+        { 0x5aad, 0x1964, 0x240c, 0xb43f, 0x7b04, 0x75aa, 0x16b0, 0x262c, 0x6e84, 0xa236, 0xa037, 0xb4d1, 0xc8d0, 0x8ea7, 0x7edc, 0x1429 },
+        { 0xebd8, 0xa8a4, 0x9564, 0xb78a, 0x5d86, 0x2e17, 0xeecc, 0xb712, 0x1cf4, 0x0879, 0x9ed1, 0xc0b9, 0x7919, 0xf9f4, 0x953d, 0x4fbf },
+    },
+    {
+        { 0x0fde, 0x22d9, 0xb745, 0x6c0f, 0xb96e, 0xcd9f, 0x70ba, 0x1ac0, 0xb301, 0xad7d, 0x22da, 0x392e, 0xebf4, 0xf50f, 0xb46e, 0x5fd0 },
+        { 0x9bef, 0x34fa, 0x7f74, 0xf87b, 0x8e0f, 0xf062, 0xc0f8, 0x6fda, 0x03c8, 0x44a6, 0xbd2f, 0x4dc5, 0xb59a, 0x9dc2, 0xe8c0, 0x59c1 },
+        { 0x360c, 0xa5d1, 0x7a36, 0x79d5, 0xb579, 0x82e6, 0x2338, 0xc312, 0x34f8, 0xf374, 0xe31c, 0x3ca7, 0xa813, 0xd40e, 0x4bf6, 0x2fdc },
+    },
+    {
+        { 0xf666, 0xa363, 0xc8ee, 0xe93f, 0x562a, 0x7e81, 0x4851, 0x0209, 0xa12e, 0xfa7c, 0x27a2, 0xbd0b, 0xfdd3, 0x2866, 0xc3bd, 0x7490 },
+        { 0x53be, 0x3016, 0x0948, 0x0bb3, 0xf875, 0x6942, 0x8800, 0xe288, 0x3fda, 0x5204, 0x1a1b, 0xdfb4, 0xaa31, 0xdce4, 0x875b, 0x2ec7 },
+        { 0x2536, 0x1bf5, 0x33a7, 0xb2af, 0xf983, 0x7ab8, 0xfb0c, 0x954b, 0xaae8, 0xd224, 0xdd3a, 0x5eed, 0x39b5, 0xff17, 0x6559, 0x2ffc },
+    },
+    {
+        { 0x61e3, 0xb328, 0x1a60, 0xecc4, 0x835f, 0x8d72, 0x6add, 0x31f2, 0x8c1b, 0xe7d1, 0xa10f, 0x81db, 0x44be, 0xdbf1, 0x28a7, 0x7d9c },
+        { 0x54ec, 0xa7f2, 0xbeda, 0x3a57, 0xa4f6, 0x2e4e, 0x1de9, 0x5162, 0xad21, 0x7e90, 0x308c, 0x0816, 0xb559, 0xb4c2, 0x9bf0, 0x7271 },
+        { 0x6f05, 0xe9d6, 0x2718, 0xa3d5, 0x9023, 0xd68d, 0xa59d, 0xf2a6, 0xb967, 0xb1ba, 0x35c5, 0x801e, 0x011a, 0xd28b, 0x287b, 0x4c70 },
+    },
+};
@@ -0,0 +1,277 @@
+#include "boot.h"
+
+/*
+ * Flattened Device Tree Discovery
+ *
+ * A single read-only pass over the DTB the previous stage passes in a1
+ * (QEMU's reset ROM does): the first /memory range, the number of enabled
+ * /cpus/cpu nodes, the first ns16550a UART and every virtio,mmio slot.
+ * Nothing is copied or modified, and a blob that fails the header and
+ * bounds checks is ignored, so boards without a DTB keep their
+ * compile-time defaults.
+ *
+ * Properties precede subnodes in a DTB, so each node's facts are collected
+ * in a small per-depth record and acted on at its END_NODE.
+ */
+
+#define FDT_MAGIC           0xD00DFEED
+#define FDT_BEGIN_NODE      1
+#define FDT_END_NODE        2
+#define FDT_PROP            3
+#define FDT_NOP             4
+#define FDT_END             9
+
+#define FDT_MAX_DEPTH       8
+
+#define NODE_OTHER          0
+#define NODE_MEMORY         1
+#define NODE_CPU            2
+#define NODE_UART           3
+#define NODE_VIRTIO         4
+
+typedef struct {
+    uint8_t addr_cells;     /* #address-cells for this node's children */
+    uint8_t size_cells;     /* #size-cells for this node's children */
+    uint8_t kind;           /* NODE_* */
+    uint8_t disabled;       /* status = "disabled" */
+    uint8_t is_cpus;        /* The /cpus container */
+    const uint8_t *reg;
+    uint32_t reg_len;
+} fdt_node_t;
+
+uintptr_t fdt_boot_blob;
+
+/* Compare a NUL-terminated property string with @s */
+static int fdt_streq(const char *a, const char *s) {
+    while (*a && *a == *s) {
+        a++;
+        s++;
+    }
+    return *a == *s;
+}
+
+/* Node name matches @s exactly or as "<s>@<unit-address>" */
+static int fdt_name_is(const char *name, const char *s) {
+    while (*s && *name == *s) {
+        name++;
+        s++;
+    }
+    return *s == '\0' && (*name == '\0' || *name == '@');
+}
+
+/* Does the stringlist property @val contain @s? */
+static int fdt_list_has(const char *val, uint32_t len, const char *s) {
+    uint32_t i = 0;
+    while (i < len) {
+        if (fdt_streq(val + i, s)) {
+            return 1;
+        }
+        while (i < len && val[i]) {
+            i++;
+        }
+        i++;
+    }
+    return 0;
+}
+
+/* One or two big-endian cells; wider values are rejected by the caller */
+static uint64_t fdt_cells(const uint8_t *p, unsigned cells) {
+    uint64_t v = load_be32(p);
+    if (cells == 2) {
+        v = (v << 32) | load_be32(p + 4);
+    }
+    return v;
+}
+
+/* First (base, size) of a reg property; 0 if it cannot be represented */
+static int fdt_reg(const fdt_node_t *parent, const fdt_node_t *node,
+                   uintptr_t *base, uintptr_t *size) {
+    unsigned ac = parent->addr_cells, sc = parent->size_cells;
+    if (!node->reg || ac < 1 || ac > 2 || sc > 2 || node->reg_len < 4 * (ac + sc)) {
+        return 0;
+    }
+    uint64_t b = fdt_cells(node->reg, ac);
+    uint64_t s = sc ? fdt_cells(node->reg + 4 * ac, sc) : 0;
+    if (b > UINTPTR_MAX) {
+        return 0;
+    }
+    /* Clamp ranges that run past the end of the address space (RV32) */
+    if (s > (uint64_t)(UINTPTR_MAX - (uintptr_t)b)) {
+        s = UINTPTR_MAX - (uintptr_t)b;
+    }
+    *base = (uintptr_t)b;
+    *size = (uintptr_t)s;
+    return 1;
+}
+
+static void fdt_node_done(const fdt_node_t *parent, const fdt_node_t *node, fdt_info_t *info) {
+    uintptr_t base, size;
+    if (node->disabled) {
+        return;
+    }
+    switch (node->kind) {
+    case NODE_MEMORY:
+        if (info->ram_size == 0 && fdt_reg(parent, node, &base, &size) && size) {
+            info->ram_base = base;
+            info->ram_size = size;
+        }
+        break;
+    case NODE_CPU:
+        info->harts++;
+        break;
+    case NODE_UART:
+        if (info->uart_base == 0 && fdt_reg(parent, node, &base, &size)) {
+            info->uart_base = base;
+        }
+        break;
+    case NODE_VIRTIO:
+        if (info->virtio_count < FDT_MAX_VIRTIO && fdt_reg(parent, node, &base, &size)) {
+            info->virtio_base[info->virtio_count++] = base;
+        }
+        break;
+    }
+}
+
+/* Header and bounds checks; returns the blob size or 0 */
+static uint32_t fdt_check(const uint8_t *fdt) {
+    if (!fdt || ((uintptr_t)fdt & 3) || load_be32(fdt) != FDT_MAGIC) {
+        return 0;
+    }
+    uint32_t total = load_be32(fdt + 4);
+    uint32_t off_struct = load_be32(fdt + 8);
+    uint32_t off_strings = load_be32(fdt + 12);
+    uint32_t version = load_be32(fdt + 20);
+    uint32_t size_strings = load_be32(fdt + 32);
+    uint32_t size_struct = load_be32(fdt + 36);
+    /* v17 blobs carry size_dt_struct; v16 and older are not supported */
+    if (version < 17 || total < 40 || (off_struct & 3) ||
+        off_struct > total || size_struct > total - off_struct ||
+        off_strings > total || size_strings > total - off_strings) {
+        return 0;
+    }
+    return total;
+}
+
+int fdt_scan(const void *blob, fdt_info_t *info) {
+    const uint8_t *fdt = (const uint8_t *)blob;
+    memset(info, 0, sizeof(*info));
+    if (fdt_check(fdt) == 0) {
+        return -1;
+    }
+
+    const uint8_t *p = fdt + load_be32(fdt + 8);
+    const uint8_t *end = p + load_be32(fdt + 36);
+    const char *strings = (const char *)fdt + load_be32(fdt + 12);
+    uint32_t strings_size = load_be32(fdt + 32);
+
+    /* node[0] stands in for the root's parent: spec default cells */
+    fdt_node_t node[FDT_MAX_DEPTH + 1];
+    int depth = 0;
+    node[0].addr_cells = 2;
+    node[0].size_cells = 1;
+
+    while (p + 4 <= end) {
+        uint32_t token = load_be32(p);
+        p += 4;
+
+        if (token == FDT_BEGIN_NODE) {
+            const char *name = (const char *)p;
+            while (p < end && *p) {
+                p++;
+            }
+            p = (const uint8_t *)(((uintptr_t)p + 4) & ~(uintptr_t)3);
+            if (++depth > FDT_MAX_DEPTH) {
+                return -1;
+            }
+            fdt_node_t *n = &node[depth];
+            n->addr_cells = 2;
+            n->size_cells = 1;
+            n->kind = NODE_OTHER;
+            n->disabled = 0;
+            n->is_cpus = (depth == 2 && fdt_name_is(name, "cpus"));
+            n->reg = NULL;
+            n->reg_len = 0;
+            if (depth == 2 && fdt_name_is(name, "memory")) {
+                n->kind = NODE_MEMORY;
+            }
+        } else if (token == FDT_END_NODE) {
+            if (depth == 0) {
+                return -1;
+            }
+            fdt_node_done(&node[depth - 1], &node[depth], info);
+            depth--;
+        } else if (token == FDT_PROP) {
+            if (p + 8 > end || depth == 0) {
+                return -1;
+            }
+            uint32_t len = load_be32(p);
+            uint32_t nameoff = load_be32(p + 4);
+            const uint8_t *val = p + 8;
+            if (len > (uint32_t)(end - val) || nameoff >= strings_size) {
+                return -1;
+            }
+            p = (const uint8_t *)(((uintptr_t)val + len + 3) & ~(uintptr_t)3);
+
+            fdt_node_t *n = &node[depth];
+            const char *name = strings + nameoff;
+            const char *sval = (const char *)val;
+            if (fdt_streq(name, "#address-cells") && len == 4) {
+                n->addr_cells = (uint8_t)load_be32(val);
+            } else if (fdt_streq(name, "#size-cells") && len == 4) {
+                n->size_cells = (uint8_t)load_be32(val);
+            } else if (fdt_streq(name, "reg")) {
+                n->reg = val;
+                n->reg_len = len;
+            } else if (fdt_streq(name, "status") && len) {
+                n->disabled = !fdt_list_has(sval, len, "okay") && !fdt_list_has(sval, len, "ok");
+            } else if (fdt_streq(name, "device_type") && len) {
+                if (fdt_list_has(sval, len, "memory") && depth == 2) {
+                    n->kind = NODE_MEMORY;
+                } else if (fdt_list_has(sval, len, "cpu") && node[depth - 1].is_cpus) {
+                    n->kind = NODE_CPU;
+                }
+            } else if (fdt_streq(name, "compatible") && len) {
+                if (fdt_list_has(sval, len, "ns16550a")) {
+                    n->kind = NODE_UART;
+                } else if (fdt_list_has(sval, len, "virtio,mmio")) {
+                    n->kind = NODE_VIRTIO;
+                }
+            }
+        } else if (token == FDT_NOP) {
+            continue;
+        } else if (token == FDT_END) {
+            return depth == 0 ? 0 : -1;
+        } else {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+uintptr_t fdt_usable_end(const void *blob, uintptr_t from, uintptr_t end) {
+    const uint8_t *fdt = (const uint8_t *)blob;
+    uint32_t total = fdt_check(fdt);
+    if (total == 0) {
+        return end;
+    }
+
+    /* The blob itself (QEMU puts it near the top of RAM) */
+    if ((uintptr_t)fdt >= from && (uintptr_t)fdt < end) {
+        end = (uintptr_t)fdt;
+    }
+
+    /* Memory reservation block: (address, size) pairs of 64-bit values,
+     * terminated by a zero size */
+    const uint8_t *rsv = fdt + load_be32(fdt + 16);
+    for (; rsv + 16 <= fdt + total; rsv += 16) {
+        uint64_t addr = fdt_cells(rsv, 2);
+        uint64_t size = fdt_cells(rsv + 8, 2);
+        if (size == 0) {
+            break;
+        }
+        if (addr >= from && addr < end) {
+            end = (uintptr_t)addr;
+        }
+    }
+    return end;
+}
@@ -5,21 +5,107 @@
  *
  * Purpose: Provide simple, safe operations used by the bootloader while
  * protecting the bootloader and enforcing partition bounds.
+ *
+ * Everything is built on the asynchronous HAL contract (submit, poll,
+ * completion callback): the blocking calls are submit + flash_wait(), and
+ * callers that have other work (UART draining, checksums) submit and poll
+ * themselves.
  */
 
-int flash_write(uint32_t addr, const void *data, size_t size) {
-    /* Ensure the write stays within the application partition bounds */
-    if (addr < APP_BASE || (addr + size) > (APP_BASE + APP_MAX_SIZE)) {
+/* Range lies entirely within [base, base + len) (overflow-safe) */
+static RAMFUNC int flash_in(uintptr_t addr, size_t size, uintptr_t base, size_t len) {
+    return addr >= base && size <= len && addr - base <= len - size;
+}
+
+RAMFUNC int flash_submit(int op, uintptr_t addr, const void *data, size_t size,
+                 flash_done_fn done, void *ctx) {
+    /* Only the application partition and the boot state sector are writable */
+    if (!flash_in(addr, size, APP_BASE, APP_MAX_SIZE) &&
+        !flash_in(addr, size, STATE_BASE, STATE_SIZE)) {
+        return -1;
+    }
+    if (op == FLASH_OP_ERASE &&
+        ((addr | size) & (FLASH_SECTOR_SIZE - 1)) != 0) {
+        return -1;
+    }
+    return platform_flash_submit(op, addr, data, size, done, ctx);
+}
+
+RAMFUNC int flash_poll(void) {
+    return platform_flash_poll();
+}
+
+RAMFUNC int flash_wait(void) {
+    int rc;
+    /* Boards with a watchdog would feed it here: erases can take seconds */
+    while ((rc = platform_flash_poll()) == 1) {
+    }
+    return rc;
+}
+
+RAMFUNC int flash_write(uintptr_t addr, const void *data, size_t size) {
+    if (flash_submit(FLASH_OP_WRITE, addr, data, size, NULL, NULL) != 0) {
+        return -1;
+    }
+    return flash_wait();
+}
+
+RAMFUNC int flash_write_start(uintptr_t addr, const void *data, size_t size) {
+    return flash_submit(FLASH_OP_WRITE, addr, data, size, NULL, NULL);
+}
+
+RAMFUNC int flash_erase(uintptr_t addr, size_t size) {
+    if (flash_submit(FLASH_OP_ERASE, addr, NULL, size, NULL, NULL) != 0) {
         return -1;
     }
-    
-    /* Delegate to the platform-specific flash write implementation */
-    return platform_flash_write(addr, data, size);
+    return flash_wait();
 }
 
-int flash_erase_app(void) {
-    /* Erase the entire application partition (may take time on real flash) */
-    return platform_flash_erase(APP_BASE, APP_MAX_SIZE);
+/*
+ * Partition erase as one chained job: each sector's completion callback
+ * submits the next sector that is not already blank (a blank check is a
+ * plain read, far cheaper than an erase cycle). The job, its wait loop and
+ * the submit path are all RAMFUNC: the callback is entered with the flash
+ * idle, but returns through flash_submit() with the next erase in flight.
+ */
+typedef struct {
+    uintptr_t next;     /* Next sector to look at */
+    uintptr_t end;      /* First sector past the range */
+    int status;         /* 1 = running, 0 = done, -1 = failed */
+} erase_job_t;
+
+static RAMFUNC void erase_app_step(int status, void *ctx) {
+    erase_job_t *job = (erase_job_t *)ctx;
+    if (status != 0) {
+        job->status = -1;
+        return;
+    }
+    for (; job->next < job->end; job->next += FLASH_SECTOR_SIZE) {
+        if (mem_is_blank((const void *)job->next, FLASH_SECTOR_SIZE)) {
+            continue;
+        }
+        uintptr_t addr = job->next;
+        job->next += FLASH_SECTOR_SIZE;
+        if (flash_submit(FLASH_OP_ERASE, addr, NULL, FLASH_SECTOR_SIZE, erase_app_step, job) != 0) {
+            job->status = -1;
+        }
+        return;
+    }
+    job->status = 0;
+}
+
+RAMFUNC int flash_erase_app(uint32_t size) {
+    if (size > APP_MAX_SIZE) {
+        return -1;
+    }
+    /* Whole sectors; APP_MAX_SIZE is sector aligned, so this cannot wrap */
+    uint32_t span = (size + FLASH_SECTOR_SIZE - 1) & ~(uint32_t)(FLASH_SECTOR_SIZE - 1);
+    erase_job_t job = { APP_BASE, APP_BASE + span, 1 };
+    erase_app_step(0, &job);
+    while (job.status == 1) {
+        flash_poll();
+    }
+    return job.status;
 }
 
 int flash_write_header(const fw_header_t *header) {
@@ -28,5 +114,5 @@ int flash_write_header(const fw_header_t *header) {
      * step of a successful update. Writing the header last signals a valid
      * firmware image to the bootloader on next boot (atomicity goal).
      */
-    return platform_flash_write(APP_BASE, header, sizeof(fw_header_t));
+    return flash_write(APP_BASE, header, sizeof(fw_header_t));
 }
@@ -0,0 +1,183 @@
+#include "boot.h"
+
+/*
+ * Image Install Pipeline
+ *
+ * Responsibilities:
+ * - Stream a payload into the APP partition through the flash layer
+ * - Keep a running CRC and SHA-256 so no second pass over the image is needed
+ * - Commit the header last (atomicity goal, see flash_write_header)
+ *
+ * Used by every image source: UART update protocol, block devices, etc.
+ */
+
+#define APP_PAYLOAD_BASE    (APP_BASE + sizeof(fw_header_t))
+#define APP_PAYLOAD_MAX     (APP_MAX_SIZE - sizeof(fw_header_t))
+
+int image_begin(image_writer_t *w, const fw_header_t *packed, uint32_t size) {
+    if (packed) {
+        if (!fw_header_reserved_clear(packed)) {
+            return IMAGE_ERR_HEADER;
+        }
+        memcpy(&w->header, packed, sizeof(fw_header_t));
+        w->packed = 1;
+    } else {
+        memset(&w->header, 0, sizeof(fw_header_t));
+        w->header.magic = BOOT_MAGIC;
+        w->header.size = size;
+        w->header.version = 1;
+        w->packed = 0;
+    }
+    w->written = 0;
+    w->crc = 0;
+    sha256_init(&w->sha);
+
+    /* Ensure the payload fits within the application partition */
+    if (w->header.size == 0 || w->header.size > APP_PAYLOAD_MAX) {
+        return IMAGE_ERR_SIZE;
+    }
+
+    /* Erase what the image will occupy (may be time-consuming) */
+    if (flash_erase_app(sizeof(fw_header_t) + w->header.size) != 0) {
+        return IMAGE_ERR_ERASE;
+    }
+    return IMAGE_OK;
+}
+
+RAMFUNC int image_feed_start(image_writer_t *w, const uint8_t *data, size_t len) {
+    if (len > w->header.size - w->written) {
+        return IMAGE_ERR_SIZE;
+    }
+    if (flash_write_start(APP_PAYLOAD_BASE + w->written, data, len) != 0) {
+        return IMAGE_ERR_WRITE;
+    }
+    /* Checksums overlap the programming (the flash only reads @data) */
+    w->crc = crc32_update(w->crc, data, len);
+    sha256_update(&w->sha, data, len);
+    w->written += len;
+    return IMAGE_OK;
+}
+
+RAMFUNC int image_poll(image_writer_t *w) {
+    (void)w;
+    int rc = flash_poll();
+    if (rc < 0) {
+        return IMAGE_ERR_WRITE;
+    }
+    return rc ? IMAGE_BUSY : IMAGE_OK;
+}
+
+RAMFUNC int image_feed(image_writer_t *w, const uint8_t *data, size_t len) {
+    int err = image_feed_start(w, data, len);
+    while (err == IMAGE_OK && (err = image_poll(w)) == IMAGE_BUSY) {
+    }
+    return err;
+}
+
+int image_finish(image_writer_t *w) {
+    if (w->written != w->header.size) {
+        return IMAGE_ERR_SIZE;
+    }
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_final(&w->sha, digest);
+
+    if (w->packed) {
+        /* Packed images carry their own CRC/digest: they must match */
+        if (w->crc != w->header.crc32) {
+            return IMAGE_ERR_CRC;
+        }
+        if ((w->header.flags & FW_FLAG_SHA256) &&
+            memcmp(digest, w->header.sha256, SHA256_DIGEST_SIZE) != 0) {
+            return IMAGE_ERR_CRC;
+        }
+    } else {
+        /* Raw images get the digest computed during receive */
+        w->header.crc32 = w->crc;
+        w->header.flags |= FW_FLAG_SHA256;
+        memcpy(w->header.sha256, digest, SHA256_DIGEST_SIZE);
+    }
+
+    /* Write header last to mark a valid firmware image atomically */
+    if (flash_write_header(&w->header) != 0) {
+        return IMAGE_ERR_HEADER;
+    }
+    return IMAGE_OK;
+}
+
+/* image_install() body; @image_chunk is the arena staging buffer */
+static int image_install_from(image_read_fn read, uint32_t avail, uint8_t *image_chunk) {
+    image_writer_t w;
+    const fw_header_t *packed = NULL;
+    uint32_t offset = 0;
+    uint32_t end = avail;
+    int err;
+
+    /* The first chunk tells packed and raw images apart */
+    uint32_t len = (avail < IMAGE_CHUNK_SIZE) ? avail : IMAGE_CHUNK_SIZE;
+    if (len == 0) {
+        return IMAGE_ERR_SIZE;
+    }
+    if (read(0, image_chunk, len) != 0) {
+        return IMAGE_ERR_READ;
+    }
+
+    if (len >= sizeof(fw_header_t) && ((const fw_header_t *)image_chunk)->magic == BOOT_MAGIC) {
+        packed = (const fw_header_t *)image_chunk;
+        /* Sources may be padded (e.g. whole disk sectors): trust the header */
+        if (packed->size > avail - sizeof(fw_header_t)) {
+            return IMAGE_ERR_SIZE;
+        }
+        offset = sizeof(fw_header_t);
+        end = sizeof(fw_header_t) + packed->size;
+    }
+
+    err = image_begin(&w, packed, end - offset);
+    if (err != IMAGE_OK) {
+        return err;
+    }
+
+    /* Stream chunk by chunk; the first one is already staged */
+    uint32_t chunk_base = 0;
+    while (1) {
+        uint32_t chunk_end = chunk_base + len;
+        if (chunk_end > end) {
+            chunk_end = end;
+        }
+        if (chunk_end > offset) {
+            uint32_t done = w.written;
+            err = image_feed(&w, image_chunk + (offset - chunk_base), chunk_end - offset);
+            if (err != IMAGE_OK) {
+                return err;
+            }
+            image_progress(done, w.written);
+            offset = chunk_end;
+        }
+        if (offset >= end) {
+            break;
+        }
+
+        chunk_base += IMAGE_CHUNK_SIZE;
+        len = (end - chunk_base < IMAGE_CHUNK_SIZE) ? end - chunk_base : IMAGE_CHUNK_SIZE;
+        if (read(chunk_base, image_chunk, len) != 0) {
+            return IMAGE_ERR_READ;
+        }
+    }
+
+    return image_finish(&w);
+}
+
+void image_progress(uint32_t before, uint32_t after) {
+    if ((before >> IMAGE_PROGRESS_SHIFT) != (after >> IMAGE_PROGRESS_SHIFT)) {
+        emit_bl_evt_progress(after);
+    }
+}
+
+int image_install(image_read_fn read, uint32_t avail) {
+    /* Staging buffer for pull-style sources: arena memory, install phase only */
+    size_t mark = arena_mark();
+    uint8_t *chunk = arena_alloc(IMAGE_CHUNK_SIZE);
+    int err = chunk ? image_install_from(read, avail, chunk) : IMAGE_ERR_NOMEM;
+    arena_release(mark);
+    return err;
+}
@@ -5,7 +5,8 @@
  *
  * Responsibilities:
  * - Present a simple UART-based update protocol
- * - Validate firmware image (magic, size, CRC)
+ * - Install images from bulk sources (block device)
+ * - Validate firmware image (magic, size, CRC, digest, signature)
  * - Perform flash erase/write via HAL and jump to the application
  *
  * Design goals: small, auditable, and explicit behavior for reviews
@@ -19,40 +20,332 @@ static void print_banner(void) {
     uart_puts("======================================\n");
 }
 
-static void emit_bl_evt(const char *token) {
-    uart_puts("BL_EVT:");
-    uart_puts(token);
-    uart_puts("\n");
+/*
+ * verify_signature - Check the Ed25519 signature over the header digest
+ * @quiet: No events and no boot-state write (the result is not cached)
+ * Only called once the digest has been recomputed and matched, so a cached
+ * result for that digest (same key) proves the image is the verified one.
+ * Cold (full verify) and warm (cache hit) costs are reported in cycles.
+ * Returns 0 on success, -1 on failure
+ */
+static int verify_signature(const fw_header_t *header, int quiet) {
+    boot_state_t st;
+    uint32_t key_tag = crc32(ed25519_public_key, ED25519_KEY_SIZE);
+    uint32_t start = cycle_count();
+
+    if (state_load(&st) == 0 && st.key_tag == key_tag &&
+        memcmp(st.verified, header->sha256, SHA256_DIGEST_SIZE) == 0) {
+        if (!quiet) {
+            emit_bl_evt_u32("SIG_VERIFY_WARM", cycle_count() - start);
+        }
+        return 0;
+    }
+
+    int rc = ed25519_verify(header->signature, header->sha256, SHA256_DIGEST_SIZE);
+    if (!quiet) {
+        emit_bl_evt_u32("SIG_VERIFY_COLD", cycle_count() - start);
+    }
+    if (rc != 0) {
+        return -1;
+    }
+    if (quiet) {
+        return 0;
+    }
+
+    /* Remember the result; a failed store only costs a cold verify later */
+    st.key_tag = key_tag;
+    memcpy(st.verified, header->sha256, SHA256_DIGEST_SIZE);
+    state_store(&st);
+    return 0;
 }
 
 /*
- * validate_app - Verify the firmware header at APP_BASE
- * Checks: magic number, plausibility of size, and CRC32 over payload
- * Returns 0 on success, -1 on failure
+ * Resumable integrity check of the installed image (CRC32 and, if the
+ * header carries one, the SHA-256 digest, in the same pass). main() runs
+ * it a step at a time while waiting at BOOT?, so by the time the user
+ * decides, the result is usually known already.
  */
-static int validate_app(void) {
-    const fw_header_t *header = (const fw_header_t *)APP_BASE;
-    
-    /* Basic header sanity checks */
-    if (header->magic != BOOT_MAGIC) {
-        uart_puts("Error: Invalid magic number\n");
+#define APP_CHECK_RUNNING   1
+#define APP_CHECK_PASSED    0
+#define APP_CHECK_FAILED    (-1)
+
+/* Payload bytes per step: short enough that a key press or the start of an
+ * upload is picked up (the UART FIFO is drained between steps) */
+#define APP_CHECK_STEP      1024
+
+typedef struct {
+    const fw_header_t *header;
+    uint32_t off;           /* Payload bytes checked so far */
+    uint32_t crc;
+    int status;             /* APP_CHECK_* */
+    const char *reason;     /* Short failure reason (INFO err=) */
+    const char *error;      /* Reported when the result is used */
+    sha256_ctx_t sha;
+} app_check_t;
+
+static void app_check_fail(app_check_t *c, const char *reason, const char *error) {
+    c->status = APP_CHECK_FAILED;
+    c->reason = reason;
+    c->error = error;
+}
+
+/* Header sanity checks; the payload pass is left to app_check_step() */
+static void app_check_begin(app_check_t *c) {
+    c->header = (const fw_header_t *)APP_BASE;
+    c->off = 0;
+    c->crc = 0;
+    c->status = APP_CHECK_RUNNING;
+    c->reason = NULL;
+    c->error = NULL;
+    sha256_init(&c->sha);
+
+    if (c->header->magic != BOOT_MAGIC) {
+        app_check_fail(c, "magic", "Error: Invalid magic number\n");
+    } else if (c->header->size == 0 ||
+               c->header->size > APP_MAX_SIZE - sizeof(fw_header_t)) {
+        /* Ensure reported size fits within the application partition */
+        app_check_fail(c, "size", "Error: Invalid firmware size\n");
+    } else if (!fw_header_reserved_clear(c->header)) {
+        app_check_fail(c, "reserved", "Error: Reserved header fields set\n");
+    }
+}
+
+/* Advance the payload pass by up to @budget bytes; returns APP_CHECK_* */
+static int app_check_step(app_check_t *c, uint32_t budget) {
+    if (c->status != APP_CHECK_RUNNING) {
+        return c->status;
+    }
+
+    const fw_header_t *header = c->header;
+    const uint8_t *payload = (const uint8_t *)(APP_BASE + sizeof(fw_header_t));
+    int check_sha = (header->flags & FW_FLAG_SHA256) != 0;
+    uint32_t end = (header->size - c->off > budget) ? c->off + budget : header->size;
+
+    /* Compute CRC (and digest) chunk by chunk so data is read only once */
+    while (c->off < end) {
+        uint32_t n = end - c->off;
+        if (n > IMAGE_CHUNK_SIZE) {
+            n = IMAGE_CHUNK_SIZE;
+        }
+        c->crc = crc32_update(c->crc, payload + c->off, n);
+        if (check_sha) {
+            sha256_update(&c->sha, payload + c->off, n);
+        }
+        c->off += n;
+    }
+    if (c->off < header->size) {
+        return APP_CHECK_RUNNING;
+    }
+
+    if (c->crc != header->crc32) {
+        app_check_fail(c, "crc", "Error: CRC mismatch\n");
+        return c->status;
+    }
+    if (check_sha) {
+        uint8_t digest[SHA256_DIGEST_SIZE];
+        sha256_final(&c->sha, digest);
+        if (memcmp(digest, header->sha256, SHA256_DIGEST_SIZE) != 0) {
+            app_check_fail(c, "sha", "Error: SHA-256 mismatch\n");
+            return c->status;
+        }
+    }
+    c->status = APP_CHECK_PASSED;
+    return c->status;
+}
+
+/*
+ * app_verdict - Finish the check and apply the signature policy
+ * @c: Check started with app_check_begin(), possibly already advanced
+ * @quiet: No output and no boot-state write, so INFO can ask at any time
+ * Checks: magic number, plausibility of size, CRC32 over payload and, if
+ * the header carries one, the SHA-256 digest (same pass over the payload),
+ * then the signature over that digest
+ * Returns NULL if the image may boot, else its failure reason ("magic",
+ * "size", "reserved", "crc", "sha", "sig" or "unsigned"; c->error has the
+ * message)
+ */
+static const char *app_verdict(app_check_t *c, int quiet) {
+    while (app_check_step(c, APP_CHECK_STEP) == APP_CHECK_RUNNING) {
+    }
+    if (c->status != APP_CHECK_PASSED) {
+        return c->reason;
+    }
+
+    const fw_header_t *header = c->header;
+    int check_sha = (header->flags & FW_FLAG_SHA256) != 0;
+    if (header->flags & FW_FLAG_SIGNED) {
+        if (!check_sha || verify_signature(header, quiet) != 0) {
+            app_check_fail(c, "sig", "Error: Signature invalid\n");
+        }
+    } else if (PLATFORM_REQUIRE_SIGNATURE) {
+        app_check_fail(c, "unsigned", "Error: Image not signed\n");
+    }
+    return c->status == APP_CHECK_PASSED ? NULL : c->reason;
+}
+
+/* validate_app - app_verdict() for the boot path: prints the error */
+static int validate_app(app_check_t *c) {
+    if (app_verdict(c, 0) != NULL) {
+        uart_puts(c->error);
         return -1;
     }
-    
-    /* Ensure reported size fits within the application partition */
-    if (header->size == 0 || header->size > APP_MAX_SIZE - sizeof(fw_header_t)) {
-        uart_puts("Error: Invalid firmware size\n");
+    return 0;
+}
+
+/*
+ * Deferred verification (FW_FLAG_DEFERRED): hart 0 starts the app right
+ * after the header checks and the worker hart finishes the payload pass.
+ * On a mismatch the worker resets the machine at once. It never drives the
+ * flash controller, which belongs to the app by then: it leaves the image
+ * in deferred_fail, and the next boot (hart 0, no app running) moves it to
+ * the boot state, checks that image in full and ends in recovery.
+ *
+ * Contract for images that opt in (include/boot.h, FW_FLAG_DEFERRED): they
+ * run in place (the payload is not modified while it is checked), keep out
+ * of RAM below RAM_BASE + BOOT_RAM_SIZE (.data/.bss/worker stack, checked
+ * by the linker) and accept a reset at any point while the check runs.
+ * Signed images are never deferred: the signature only vouches for the
+ * digest being checked.
+ */
+#define DEFERRED_FAIL_MAGIC 0x44464552u     /* "DFER" */
+
+typedef struct {
+    uint32_t magic;         /* DEFERRED_FAIL_MAGIC ^ crc32 */
+    uint32_t crc32;         /* Header CRC32 of the image that failed */
+} deferred_fail_t;
+
+/* Not cleared by start.S, and in no LOAD segment, so a reset keeps it
+ * (linker/memory.ld) */
+static volatile deferred_fail_t deferred_fail __attribute__((section(".noinit")));
+
+static app_check_t deferred_check;
+
+static void deferred_verify(void *arg) {
+    app_check_t *c = (app_check_t *)arg;
+    while (app_check_step(c, APP_CHECK_STEP) == APP_CHECK_RUNNING) {
+    }
+    if (c->status == APP_CHECK_PASSED) {
+        return;
+    }
+
+    deferred_fail.crc32 = c->header->crc32;
+    deferred_fail.magic = DEFERRED_FAIL_MAGIC ^ c->header->crc32;
+    /* The record before the reset request */
+    __asm__ volatile ("fence" ::: "memory");
+    platform_reset();
+}
+
+/* Store a failure the worker left before its reset (no app is running, so
+ * hart 0 owns the flash controller again) */
+static void deferred_collect(void) {
+#if PLATFORM_DEFERRED_VERIFY
+    uint32_t crc = deferred_fail.crc32;
+    if (deferred_fail.magic != (DEFERRED_FAIL_MAGIC ^ crc)) {
+        return;
+    }
+    deferred_fail.magic = 0;
+
+    boot_state_t st;
+    (void)state_load(&st);
+    if (st.deferred_bad != crc) {
+        st.deferred_bad = crc;
+        (void)state_store(&st);
+    }
+#endif
+}
+
+/* Returns 0 if the check was handed to the worker and the app may start */
+static int defer_app_check(app_check_t *c) {
+#if PLATFORM_DEFERRED_VERIFY
+    const fw_header_t *header = c->header;
+    if (c->status != APP_CHECK_RUNNING || !(header->flags & FW_FLAG_DEFERRED) ||
+        (header->flags & FW_FLAG_SIGNED) || PLATFORM_REQUIRE_SIGNATURE) {
         return -1;
     }
-    
-    /* Compute CRC and compare with header CRC */
-    uint32_t calc_crc = crc32((const uint8_t *)(APP_BASE + sizeof(fw_header_t)), header->size);
-    if (calc_crc != header->crc32) {
-        uart_puts("Error: CRC mismatch\n");
+
+    /* This image already failed a deferred check: no second chance */
+    boot_state_t st;
+    if (state_load(&st) == 0 && st.deferred_bad == header->crc32) {
+        emit_bl_evt("APP_DEFERRED_BAD");
         return -1;
     }
-    
+
+    deferred_check = *c;
+    if (worker_handoff(deferred_verify, &deferred_check) != 0) {
+        return -1;
+    }
+    emit_bl_evt_u32("APP_VERIFY_DEFERRED", header->size - c->off);
     return 0;
+#else
+    (void)c;
+    return -1;
+#endif
+}
+
+/* A full check passed: the image may be deferred again (one state write) */
+static void deferred_clear(const fw_header_t *header) {
+#if PLATFORM_DEFERRED_VERIFY
+    boot_state_t st;
+    if (state_load(&st) == 0 && st.deferred_bad != 0 && st.deferred_bad == header->crc32) {
+        st.deferred_bad = 0;
+        (void)state_store(&st);
+    }
+#else
+    (void)header;
+#endif
+}
+
+/* Append @value to @p in decimal, or as 8 hex digits; returns the new end */
+static char *fmt_u32(char *p, uint32_t value, int hex) {
+    char buf[10];
+    int i = 0;
+    do {
+        uint32_t d = hex ? (value & 0xF) : (value % 10);
+        buf[i++] = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+        value = hex ? (value >> 4) : (value / 10);
+    } while (value || (hex && i < 8));
+    while (i > 0) {
+        *p++ = buf[--i];
+    }
+    return p;
+}
+
+static char *fmt_str(char *p, const char *s) {
+    while (*s) {
+        *p++ = *s++;
+    }
+    return p;
+}
+
+/*
+ * app_info - Answer INFO (key 'i' at BOOT?) with the installed image
+ * @t: Transport the request came on (the reply goes back there)
+ * @c: Speculative check from the BOOT? window; finished here if needed
+ *
+ * One line of key=value fields, so a host can compare size and CRC with
+ * the image it holds and skip the upload when they match:
+ *   INFO magic=0x5256424C size=<n> crc32=0x<8 hex> version=<n> valid=<0|1>
+ *        err=<none|magic|size|reserved|crc|sha|sig|unsigned>
+ * valid and err come from a quiet app_verdict() (CRC, digest, signature
+ * policy): nothing else is printed and the boot state is not written. The
+ * header is reported as found, even when it is not a valid one.
+ */
+static void app_info(const transport_t *t, app_check_t *c) {
+    const fw_header_t *header = (const fw_header_t *)APP_BASE;
+    const char *reason = app_verdict(c, 1);
+    int valid = reason == NULL;
+
+    char line[112];
+    char *p = fmt_str(line, "INFO magic=0x");
+    p = fmt_u32(p, header->magic, 1);
+    p = fmt_u32(fmt_str(p, " size="), header->size, 0);
+    p = fmt_u32(fmt_str(p, " crc32=0x"), header->crc32, 1);
+    p = fmt_u32(fmt_str(p, " version="), header->version, 0);
+    p = fmt_str(p, valid ? " valid=1 err=" : " valid=0 err=");
+    p = fmt_str(fmt_str(p, valid ? "none" : reason), "\n");
+    *p = '\0';
+    transport_puts(t, line);
+    emit_bl_evt_u32("APP_INFO", (uint32_t)valid);
 }
 
 /*
@@ -62,11 +355,14 @@ static int validate_app(void) {
  * - In a real loader you might: flush caches, disable interrupts, remap vectors
  */
 static void jump_to_app(void) {
+    /* Every boot path ends here: last chance to measure the stack */
+    emit_bl_evt_u32("STAT_STACK_PEAK", stats_stack_peak());
     emit_bl_evt("LOAD_APP");
     emit_bl_evt("HANDOFF");
     uart_puts("Jumping to application...\n");
     uart_puts("APP_HANDOFF\n");
     emit_bl_evt("HANDOFF_APP");
+    worker_stop();
 
     /* The application entry point is right after the header */
     void (*app_entry)(void) = (void (*)(void))(APP_BASE + sizeof(fw_header_t));
@@ -78,116 +374,546 @@ static void jump_to_app(void) {
 }
 
 /*
- * uart_update - Implements the simple UART update protocol
+ * report_image_error - Print the protocol error line for an image_* failure
+ * @t: Channel the requester is listening on
+ */
+static void report_image_error(const transport_t *t, int err) {
+    switch (err) {
+    case IMAGE_ERR_SIZE:   transport_puts(t, "ERR: SIZE\n");   break;
+    case IMAGE_ERR_ERASE:  transport_puts(t, "ERR: ERASE\n");  break;
+    case IMAGE_ERR_WRITE:  transport_puts(t, "ERR: WRITE\n");  break;
+    case IMAGE_ERR_CRC:    transport_puts(t, "ERR: CRC\n");    break;
+    case IMAGE_ERR_HEADER: transport_puts(t, "ERR: HEADER\n"); break;
+    case IMAGE_ERR_READ:   transport_puts(t, "ERR: READ\n");   break;
+    case IMAGE_ERR_NOMEM:  transport_puts(t, "ERR: NOMEM\n");  break;
+    default:               transport_puts(t, "ERR\n");         break;
+    }
+    emit_bl_evt("APP_CRC_FAIL");
+}
+
+/*
+ * reboot_after_update - Leave the bootloader once a new image is committed
+ * @t: Channel the requester is listening on
+ */
+static void reboot_after_update(const transport_t *t) {
+    transport_puts(t, "REBOOT\n");
+
+#if PLATFORM_DIRECT_BOOT_AFTER_UPDATE
+    /* QEMU demo flow: jump directly so UART can show app output immediately. */
+    jump_to_app();
+#else
+    /* Perform system reset using platform abstraction */
+    platform_reset();
+#endif
+}
+
+/* Hex digit value, -1 for anything else */
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * read_polling - Receive @len bytes while keeping a background write going
+ * @err: First write error seen while polling (left alone once set)
+ *
+ * The flash is polled whenever the transport has nothing buffered, so
+ * programming the previous chunk overlaps receiving this one.
+ */
+static RAMFUNC void read_polling(const transport_t *t, image_writer_t *w, uint8_t *buf,
+                                 size_t len, int *err) {
+    for (size_t i = 0; i < len; i++) {
+        while (!t->rx_ready()) {
+            int rc = image_poll(w);
+            if (rc < 0 && *err == IMAGE_OK) {
+                *err = rc;
+            }
+        }
+        buf[i] = (uint8_t)transport_getc(t);
+    }
+}
+
+/*
+ * receive_pingpong - Receive @size bytes into the writer without a worker
+ * @t: Transport the payload arrives on
+ * @w: Writer started by image_begin()
+ * @chunk: Two WORKER_CHUNK_SIZE buffers
+ * @size: Payload size
+ * @ctr: AES-CTR state for encrypted payloads, or NULL
+ *
+ * One buffer fills from the transport while the other is programmed. This
+ * loop, and everything it calls while a write is in flight (read_polling(),
+ * image_feed_start() and its checksums), is RAMFUNC: the flash is not
+ * fetched from between a submit and its completion. Progress events and
+ * decryption run in the idle gap after each write has finished.
+ *
+ * Returns: IMAGE_OK or the first IMAGE_ERR_*; the payload is always drained
+ */
+static RAMFUNC int receive_pingpong(const transport_t *t, image_writer_t *w,
+                                    uint8_t *chunk[2], uint32_t size, aes_ctr_t *ctr) {
+    int err = IMAGE_OK;
+    int cur = 0;
+    uint32_t received = 0;
+    while (received < size) {
+        uint32_t n = size - received;
+        if (n > WORKER_CHUNK_SIZE) {
+            n = WORKER_CHUNK_SIZE;
+        }
+
+        /* Ping-pong: fill one buffer while the other one is programmed */
+        read_polling(t, w, chunk[cur], n, &err);
+
+        /* One write in flight: finish the previous buffer first. On
+         * failure keep draining so the host sees a clean error */
+        int rc;
+        while ((rc = image_poll(w)) == IMAGE_BUSY) {
+            t->rx_ready();
+        }
+        if (err == IMAGE_OK) {
+            err = rc;
+        }
+        image_progress(received, received + n);
+        received += n;
+        if (err == IMAGE_OK) {
+            /* Decrypt in place: plaintext goes straight to the writer */
+            if (ctr) {
+                aes_ctr_xor(ctr, chunk[cur], n);
+            }
+            err = image_feed_start(w, chunk[cur], n);
+        }
+        cur ^= 1;
+    }
+
+    /* Let the last write finish, even after an error */
+    int rc;
+    while ((rc = image_poll(w)) == IMAGE_BUSY) {
+    }
+    return err == IMAGE_OK ? rc : err;
+}
+
+/*
+ * uart_update - Implements the simple update protocol over a transport
+ * @t: Channel the update was requested on (UART or auxiliary console)
+ *
  * Protocol (human-friendly):
  *  - Bootloader sends: OK
- *  - Host sends: SEND <size>\n
+ *  - Host sends: SEND <size>\n (or SEND <size> <nonce>\n, encrypted)
  *  - Bootloader: READY
  *  - Host sends raw binary of <size> bytes
  *  - Bootloader computes CRC, writes header atomically, and reboots
  *
- * Note: For QEMU this implementation writes payload directly to memory at
- * APP_BASE (simplified). On real hardware, writes must go through flash APIs
- * and respect page/sector alignment and write/erase constraints.
+ * The payload is streamed through the image pipeline (flash layer) in
+ * chunks, so the CRC is computed while bytes arrive. Two chunk buffers
+ * ping-pong: one fills from the transport while the other is programmed
+ * in the background (polled between bytes). With a worker hart, chunks go
+ * to it instead (src/worker.c). BL_EVT tokens always go to the UART log.
+ *
+ * Encrypted updates: "SEND <size> <nonce>" (24 hex digits) marks the
+ * payload as AES-CTR ciphertext under the device key
+ * (platform_update_key()). Each chunk is decrypted in place before it is
+ * fed to the writer, so the image is still touched in a single pass.
  */
-static void uart_update(void) {
+static void uart_update(const transport_t *t) {
     uint32_t size = 0;
+    uint8_t nonce[AES_CTR_NONCE_SIZE] = {0};
+    int nonce_digits = 0;
+    int nonce_bad = 0;      /* Non-hex character, extra digits or a second field */
+    int in_nonce = 0;
 
     emit_bl_evt("APP_CRC_CHECK");
-    uart_puts("OK\n");
+    transport_puts(t, "OK\n");
     
     /* Expecting "SEND " literal (very simple parser) */
     const char *cmd = "SEND ";
     for (int j = 0; j < 5; j++) {
-        if (uart_getc() != cmd[j]) {
-            uart_puts("ERR: CMD\n");
+        if (transport_getc(t) != cmd[j]) {
+            transport_puts(t, "ERR: CMD\n");
             return;
         }
     }
     
-    /* Read decimal size until newline */
+    /* Read decimal size, then an optional hex CTR nonce, until newline */
     while (1) {
-        char c = uart_getc();
+        char c = transport_getc(t);
         if (c == '\r' || c == '\n') break;
-        if (c >= '0' && c <= '9') {
-            size = size * 10 + (c - '0');
+        if (c == ' ') {
+            if (nonce_digits) {
+                nonce_bad = 1;
+            }
+            in_nonce = 1;
+        } else if (!in_nonce) {
+            /* Stop accumulating once past any valid size, so extra
+             * digits cannot wrap it back into range */
+            if (c >= '0' && c <= '9' && size <= APP_MAX_SIZE) {
+                size = dec_push(size, (uint32_t)(c - '0'));
+            }
+        } else {
+            int v = hex_value(c);
+            if (v < 0 || nonce_digits >= 2 * AES_CTR_NONCE_SIZE) {
+                nonce_bad = 1;
+            } else {
+                nonce[nonce_digits / 2] = (uint8_t)((nonce[nonce_digits / 2] << 4) | v);
+                nonce_digits++;
+            }
         }
     }
     
     /* Validate reported size against partition limits */
     if (size == 0 || size > APP_MAX_SIZE - sizeof(fw_header_t)) {
-        uart_puts("ERR: SIZE\n");
+        transport_puts(t, "ERR: SIZE\n");
         emit_bl_evt("APP_CRC_FAIL");
         return;
     }
 
-    /* Prepare header (header written last for atomic update) */
-    fw_header_t header;
-    header.magic = BOOT_MAGIC;
-    header.size = size;
-    header.version = 1;
+    /* Encrypted mode: "SEND <size> <nonce>", AES-CTR with the device key */
+    aes_ctr_t ctr;
+    int encrypted = (nonce_digits != 0 || nonce_bad);
+    if (encrypted) {
+        /* Exactly 2 * AES_CTR_NONCE_SIZE hex digits: a short or mangled
+         * nonce would decrypt into garbage that still gets flashed */
+        if (nonce_bad || nonce_digits != 2 * AES_CTR_NONCE_SIZE) {
+            transport_puts(t, "ERR: NONCE\n");
+            emit_bl_evt("APP_CRC_FAIL");
+            return;
+        }
+        const uint8_t *key;
+        size_t key_len = platform_update_key(&key);
+        if (key_len == 0 || aes_ctr_init(&ctr, key, key_len, nonce) != 0) {
+            transport_puts(t, "ERR: KEY\n");
+            emit_bl_evt("APP_CRC_FAIL");
+            return;
+        }
+        emit_bl_evt("UPDATE_DECRYPT");
+    }
+
+    /* Ping-pong buffers are arena scratch, held for the receive phase only */
+    size_t mark = arena_mark();
+    uint8_t *chunk[2] = { arena_alloc(WORKER_CHUNK_SIZE), arena_alloc(WORKER_CHUNK_SIZE) };
+    if (!chunk[1]) {
+        arena_release(mark);
+        report_image_error(t, IMAGE_ERR_NOMEM);
+        return;
+    }
 
     /* Erase application partition via HAL (may be time-consuming) */
-    uart_puts("ERASING...\n");
-    if (flash_erase_app() != 0) {
-        uart_puts("ERR: ERASE\n");
-        emit_bl_evt("APP_CRC_FAIL");
+    transport_puts(t, "ERASING...\n");
+    image_writer_t writer;
+    int err = image_begin(&writer, NULL, size);
+    if (err != IMAGE_OK) {
+        arena_release(mark);
+        report_image_error(t, err);
         return;
     }
 
-    /* Receive payload. QEMU: writes directly to memory for simplicity. */
-    uart_puts("READY\n");
-    uint8_t *dest = (uint8_t *)(APP_BASE + sizeof(fw_header_t));
-    for (uint32_t j = 0; j < size; j++) {
-        /* Blocking read per byte; keep it simple and deterministic */
-        dest[j] = (uint8_t)uart_getc();
+    /* Receive payload in chunks and stream them to flash */
+    transport_puts(t, "READY\n");
+    if (worker_online()) {
+        /* This hart only receives; the worker decrypts and programs */
+        worker_begin(&writer, encrypted ? &ctr : NULL);
+        for (uint32_t received = 0; received < size; ) {
+            uint32_t n = size - received;
+            if (n > WORKER_CHUNK_SIZE) {
+                n = WORKER_CHUNK_SIZE;
+            }
+            worker_chunk_t *c;
+            while ((c = worker_chunk_get()) == NULL) {
+                t->rx_ready(); /* Keep buffering (and flow control) going */
+            }
+            t->read(c->data, n);
+            c->len = n;
+            worker_chunk_put(c);
+            image_progress(received, received + n);
+            received += n;
+        }
+        err = worker_drain();
+    } else {
+        err = receive_pingpong(t, &writer, chunk, size, encrypted ? &ctr : NULL);
+    }
+    arena_release(mark);
+    stats_report();
+
+    /* CRC accumulated during receive is stored into the header */
+    if (err == IMAGE_OK) {
+        err = image_finish(&writer);
+    }
+    if (err != IMAGE_OK) {
+        report_image_error(t, err);
+        return;
     }
 
-    /* Compute CRC over received payload and store into header */
-    header.crc32 = crc32((const uint8_t *)(APP_BASE + sizeof(fw_header_t)), size);
-    
-    /* Write header last to mark a valid firmware image atomically */
-    if (flash_write_header(&header) != 0) {
-        uart_puts("ERR: HEADER\n");
+    emit_bl_evt("APP_CRC_OK");
+
+    transport_puts(t, "CRC?\n");
+    transport_puts(t, "OK\n");
+    reboot_after_update(t);
+}
+
+/* Block device image source: byte offsets mapped onto whole sectors */
+static int disk_read(uint32_t offset, void *buf, size_t len) {
+    size_t sectors = (len + BLK_SECTOR_SIZE - 1) / BLK_SECTOR_SIZE;
+    return platform_blk_read(offset / BLK_SECTOR_SIZE, buf, sectors);
+}
+
+/*
+ * disk_update - Install an image from sector 0 of the attached block device
+ *
+ * The disk holds either a fw_header_t-packed image (header CRC is checked)
+ * or a raw payload, in which case the whole disk (clamped to the partition)
+ * is installed. Much faster than the UART for factory/CI provisioning.
+ */
+static void disk_update(void) {
+    emit_bl_evt("APP_CRC_CHECK");
+
+    uint32_t sectors = platform_blk_init();
+    if (sectors == 0) {
+        uart_puts("ERR: NO DISK\n");
         emit_bl_evt("APP_CRC_FAIL");
         return;
     }
 
-    emit_bl_evt("APP_CRC_OK");
+    /* Disks are usually larger than the image. A packed image may fill the
+     * whole partition (image_install() takes its header off the source
+     * size); a raw disk is installed up to the partition's payload area */
+    size_t mark = arena_mark();
+    const fw_header_t *sector0 = (const fw_header_t *)arena_alloc(BLK_SECTOR_SIZE);
+    if (!sector0 || disk_read(0, (void *)sector0, BLK_SECTOR_SIZE) != 0) {
+        arena_release(mark);
+        report_image_error(&transport_uart, sector0 ? IMAGE_ERR_READ : IMAGE_ERR_NOMEM);
+        return;
+    }
+    uint32_t avail = APP_MAX_SIZE;
+    if (sector0->magic != BOOT_MAGIC) {
+        avail -= sizeof(fw_header_t);
+    }
+    arena_release(mark);
+    if (sectors < avail / BLK_SECTOR_SIZE) {
+        avail = sectors * BLK_SECTOR_SIZE;
+    }
+
+    uart_puts("DISK: LOADING...\n");
+    int err = image_install(disk_read, avail);
+    if (err != IMAGE_OK) {
+        report_image_error(&transport_uart, err);
+        return;
+    }
 
-    uart_puts("CRC?\n");
+    emit_bl_evt("APP_CRC_OK");
     uart_puts("OK\n");
-    uart_puts("REBOOT\n");
+    reboot_after_update(&transport_uart);
+}
 
-#if PLATFORM_DIRECT_BOOT_AFTER_UPDATE
-    /* QEMU demo flow: jump directly so UART can show app output immediately. */
-    jump_to_app();
-#else
-    /* Perform system reset using platform abstraction */
-    platform_reset();
+/*
+ * Host images are offered on every boot. Reinstalling one each time would
+ * cost an erase/program cycle per reset and replace whatever a UART or
+ * disk update installed since, so the boot state remembers the last host
+ * image installed (CRC32 over the image as offered, header included, so
+ * packed and raw images are told apart alike). It is installed again only
+ * when it changes, or when the installed image no longer passes its check.
+ */
+static int host_image_id(image_read_fn read, uint32_t size, uint32_t *id) {
+    size_t mark = arena_mark();
+    uint8_t *chunk = arena_alloc(IMAGE_CHUNK_SIZE);
+    int err = chunk ? 0 : -1;
+    uint32_t crc = 0;
+    for (uint32_t off = 0; err == 0 && off < size; off += IMAGE_CHUNK_SIZE) {
+        uint32_t n = (size - off < IMAGE_CHUNK_SIZE) ? size - off : IMAGE_CHUNK_SIZE;
+        err = read(off, chunk, n);
+        crc = crc32_update(crc, chunk, n);
+    }
+    arena_release(mark);
+    *id = crc;
+    return err;
+}
+
+static int host_image_current(uint32_t id) {
+    boot_state_t st;
+    if (state_load(&st) != 0 || st.host_image == 0 || st.host_image != id) {
+        return 0;
+    }
+    app_check_t check;
+    app_check_begin(&check);
+    while (app_check_step(&check, APP_CHECK_STEP) == APP_CHECK_RUNNING) {
+    }
+    return check.status == APP_CHECK_PASSED;
+}
+
+/* Install one host-side image, announcing it with @token:<size>, unless
+ * it was installed before (BL_EVT:HOST_IMAGE_CURRENT) */
+static void provision_from(const char *token, image_read_fn read, uint32_t size) {
+    emit_bl_evt_u32(token, size);
+    uint32_t id;
+    int have_id = host_image_id(read, size, &id) == 0;
+    if (have_id && host_image_current(id)) {
+        emit_bl_evt("HOST_IMAGE_CURRENT");
+        return;
+    }
+    emit_bl_evt("APP_CRC_CHECK");
+    int err = image_install(read, size);
+    if (err != IMAGE_OK) {
+        report_image_error(&transport_uart, err);
+        return;
+    }
+    emit_bl_evt("APP_CRC_OK");
+
+    boot_state_t st;
+    (void)state_load(&st);
+    if (have_id && st.host_image != id) {
+        st.host_image = id;
+        (void)state_store(&st);
+    }
+}
+
+/*
+ * host_image_provision - Install a host-provided image found at boot
+ *
+ * CI/factory path: QEMU passes the image via fw_cfg (opt/rvbl/app) and it
+ * is DMA'd chunk by chunk into the staging buffer, so no UART transfer is
+ * needed. Development path: the app file is read from the host filesystem
+ * through semihosting. An image installed on an earlier boot is left alone
+ * (provision_from()). The normal BOOT? flow continues afterwards.
+ */
+static void host_image_provision(void) {
+    uint32_t size = platform_hostimg_open();
+    if (size != 0) {
+        provision_from("HOST_IMAGE", platform_hostimg_read, size);
+        return;
+    }
+
+#if PLATFORM_SEMIHOSTING
+    size = semihost_image_open(PLATFORM_SEMIHOSTING_IMAGE);
+    if (size != 0) {
+        provision_from("SEMIHOST_IMAGE", semihost_image_read, size);
+        semihost_image_close();
+    }
 #endif
 }
 
+/*
+ * fdt_report - Report the device-tree facts and put the extra RAM to use
+ * @fdt: Result of fdt_scan()
+ *
+ * The linked memory map is the board minimum; when /memory continues past
+ * it (QEMU -m), the scratch arena grows up to the end of RAM, stopping
+ * below the DTB and any /memreserve/ entry.
+ */
+static void fdt_report(const fdt_info_t *fdt) {
+    emit_bl_evt_u32("FDT_RAM_KB", (uint32_t)(fdt->ram_size >> 10));
+    emit_bl_evt_u32("FDT_HARTS", fdt->harts);
+
+    uintptr_t ram_end = fdt->ram_base + fdt->ram_size;
+    uintptr_t linked_end = RAM_BASE + RAM_SIZE;
+    if (fdt->ram_base <= RAM_BASE && ram_end > linked_end) {
+        size_t arena = arena_grow(fdt_usable_end((const void *)fdt_boot_blob,
+                                                 linked_end, ram_end));
+        emit_bl_evt_u32("ARENA_KB", (uint32_t)(arena >> 10));
+    }
+}
+
+/*
+ * wait_key - Wait for a key on the UART or, if present, the aux console
+ * @aux: Auxiliary console transport or NULL
+ * @key: Receives the key
+ * @check: Image check to advance between polls, or NULL
+ * @timeout: Give up after this many cycles (0 = wait forever)
+ *
+ * Returns: the transport the key arrived on (replies go back there), or
+ * NULL on timeout
+ */
+static const transport_t *wait_key(const transport_t *aux, char *key,
+                                   app_check_t *check, uint32_t timeout) {
+    uint32_t start = cycle_count();
+    while (1) {
+        if (transport_uart.rx_ready()) {
+            *key = transport_getc(&transport_uart);
+            return &transport_uart;
+        }
+        if (aux && aux->rx_ready()) {
+            *key = transport_getc(aux);
+            return aux;
+        }
+        if (timeout && cycle_count() - start >= timeout) {
+            return NULL;
+        }
+        /* Idle time: validate ahead of the decision */
+        if (check) {
+            app_check_step(check, APP_CHECK_STEP);
+        }
+    }
+}
+
 int main(void) {
+    /* Board facts from the DTB, if the previous stage passed one; the
+     * UART may move, so this comes before uart_init() */
+    fdt_info_t fdt;
+    int have_fdt = 0;
+#if PLATFORM_FDT
+    have_fdt = fdt_scan((const void *)fdt_boot_blob, &fdt) == 0;
+    if (have_fdt) {
+        platform_discover(&fdt);
+    }
+#endif
+
     /* Initialize UART subsystem and show a human-friendly banner */
     uart_init();
     emit_bl_evt("INIT");
     print_banner();
     emit_bl_evt("HW_READY");
+    if (have_fdt) {
+        fdt_report(&fdt);
+    }
+
+    /* Second hart (if any) takes over decrypt/CRC/flash during updates;
+     * when the DTB shows there is none, skip the start-up timeout */
+    if (!have_fdt || fdt.harts > PLATFORM_WORKER_HART) {
+        worker_start();
+    }
+
+#ifdef CONFIG_BENCH
+    bench_run();
+#endif
+
+    deferred_collect();
+    host_image_provision();
+
+    /* Optional high-bandwidth channel: the protocol is offered on both */
+    const transport_t *aux = transport_console_open();
 
     uart_puts("BOOT?\n");
+    if (aux) {
+        transport_puts(aux, "BOOT?\n");
+    }
     
-    /* Wait for user decision. Echo character to improve UX over serial. */
+    /* Wait for user decision. Echo character to improve UX over serial.
+     * The installed image is checked speculatively in the meantime. */
+    app_check_t check;
+    app_check_begin(&check);
     while(1) {
-        char choice = uart_getc();
-        uart_putc(choice); /* Echo for visibility */
+        char choice;
+        const transport_t *t = wait_key(aux, &choice, &check, PLATFORM_BOOT_TIMEOUT_CYCLES);
+        if (!t) {
+            /* Window expired: boot as if Enter was pressed */
+            emit_bl_evt("BOOT_TIMEOUT");
+            break;
+        }
+        transport_putc(t, choice); /* Echo for visibility */
         if (choice != '\r' && choice != '\n') {
-            uart_puts("\n");
+            transport_puts(t, "\n");
         }
 
         if (choice == 'u' || choice == 'U') {
-            /* Enter firmware update mode */
-            uart_update();
+            /* Enter firmware update mode; the image may change, so the
+             * speculative check starts over */
+            uart_update(t);
+            app_check_begin(&check);
+        } else if (choice == 'i' || choice == 'I') {
+            /* Report the installed image; the host decides what is next */
+            app_info(t, &check);
+        } else if (choice == 'd' || choice == 'D') {
+            /* Install firmware from the attached block device */
+            disk_update();
+            app_check_begin(&check);
         } else if (choice == '\r' || choice == '\n') {
             /* Treat Enter as a request to boot the app */
             break;
@@ -199,9 +925,21 @@ int main(void) {
 
     /* Validate the on-flash application and jump if valid */
     emit_bl_evt("DECISION_NORMAL");
+    uint32_t decided = cycle_count();
     emit_bl_evt("APP_CRC_CHECK");
-    if (validate_app() == 0) {
+    /* Payload bytes already checked while waiting (all of it = instant) */
+    emit_bl_evt_u32("APP_PRECHECK", check.off);
+
+    /* Opt-in images start now; the worker hart finishes the check */
+    if (defer_app_check(&check) == 0) {
+        emit_bl_evt_u32("HANDOFF_CYCLES", cycle_count() - decided);
+        jump_to_app();
+    }
+
+    if (validate_app(&check) == 0) {
         emit_bl_evt("APP_CRC_OK");
+        deferred_clear(check.header);
+        emit_bl_evt_u32("HANDOFF_CYCLES", cycle_count() - decided);
         jump_to_app();
     } else {
         /* If no valid app, stay in recovery mode and allow updates */
@@ -209,8 +947,16 @@ int main(void) {
         emit_bl_evt("DECISION_RECOVERY");
         uart_puts("Recovery Loop: No valid app found. Press 'u' to update.\n");
         while(1) {
-            if (uart_getc() == 'u') {
-                uart_update();
+            char c;
+            const transport_t *t = wait_key(aux, &c, NULL, 0);
+            if (c == 'u') {
+                uart_update(t);
+            } else if (c == 'd') {
+                disk_update();
+            } else if (c == 'i') {
+                /* A failed update may have changed the partition: recheck */
+                app_check_begin(&check);
+                app_info(t, &check);
             }
         }
     }
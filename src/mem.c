@@ -0,0 +1,142 @@
+#include "boot.h"
+
+/*
+ * Freestanding memory primitives
+ *
+ * The bootloader links without a C library, but GCC may still emit calls to
+ * memcpy/memset/memcmp for aggregate copies and initializers. These minimal
+ * versions satisfy those calls and serve the bootloader's own buffer code.
+ * Aligned bulk runs move one register-width word (4 or 8 bytes) per access.
+ *
+ * RVV builds (CONFIG_RVV) hand buffers of MEM_VEC_MIN bytes and more to the
+ * vector kernels in src/vec.c; the scalar versions stay as the fallback and
+ * are exported for the benchmarks.
+ *
+ * Copy, fill and blank check are RAMFUNC: the flash completion model and the
+ * sector erase job call them while the flash is busy.
+ */
+
+/* Below this, vsetvli setup costs more than the scalar loop */
+#define MEM_VEC_MIN         64
+
+RAMFUNC void *memcpy_scalar(void *dest, const void *src, size_t n) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+    if ((((uintptr_t)d | (uintptr_t)s) & (WORD_SIZE - 1)) == 0) {
+        while (n >= WORD_SIZE) {
+            *(word_t *)d = *(const word_t *)s;
+            d += WORD_SIZE;
+            s += WORD_SIZE;
+            n -= WORD_SIZE;
+        }
+    }
+    while (n--) {
+        *d++ = *s++;
+    }
+    return dest;
+}
+
+RAMFUNC void *memset_scalar(void *dest, int c, size_t n) {
+    uint8_t *d = (uint8_t *)dest;
+    if (((uintptr_t)d & (WORD_SIZE - 1)) == 0) {
+        /* Replicate the byte across a word: 0x0101...01 * c */
+        word_t fill = (~(word_t)0 / 0xFF) * (uint8_t)c;
+        while (n >= WORD_SIZE) {
+            *(word_t *)d = fill;
+            d += WORD_SIZE;
+            n -= WORD_SIZE;
+        }
+    }
+    while (n--) {
+        *d++ = (uint8_t)c;
+    }
+    return dest;
+}
+
+int memcmp_scalar(const void *a, const void *b, size_t n) {
+    const uint8_t *pa = (const uint8_t *)a;
+    const uint8_t *pb = (const uint8_t *)b;
+    size_t i = 0;
+
+    /* Skip equal words; the first differing byte is located in-register */
+    if ((((uintptr_t)pa | (uintptr_t)pb) & (WORD_SIZE - 1)) == 0) {
+        for (; i + WORD_SIZE <= n; i += WORD_SIZE) {
+            word_t diff = *(const word_t *)(pa + i) ^ *(const word_t *)(pb + i);
+            if (diff) {
+                i += word_first_byte(diff);
+                return (int)pa[i] - (int)pb[i];
+            }
+        }
+    }
+    for (; i < n; i++) {
+        if (pa[i] != pb[i]) {
+            return (int)pa[i] - (int)pb[i];
+        }
+    }
+    return 0;
+}
+
+RAMFUNC int mem_is_blank_scalar(const void *p, size_t n) {
+    const uint8_t *s = (const uint8_t *)p;
+    while (n && ((uintptr_t)s & (WORD_SIZE - 1))) {
+        if (*s++ != 0xFF) {
+            return 0;
+        }
+        n--;
+    }
+    while (n >= WORD_SIZE) {
+        if (*(const word_t *)s != ~(word_t)0) {
+            return 0;
+        }
+        s += WORD_SIZE;
+        n -= WORD_SIZE;
+    }
+    while (n--) {
+        if (*s++ != 0xFF) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+RAMFUNC void *memcpy(void *dest, const void *src, size_t n) {
+#ifdef CONFIG_RVV
+    if (n >= MEM_VEC_MIN) {
+        vec_copy(dest, src, n);
+        return dest;
+    }
+#endif
+    return memcpy_scalar(dest, src, n);
+}
+
+RAMFUNC void *memset(void *dest, int c, size_t n) {
+#ifdef CONFIG_RVV
+    if (n >= MEM_VEC_MIN) {
+        vec_fill(dest, (uint8_t)c, n);
+        return dest;
+    }
+#endif
+    return memset_scalar(dest, c, n);
+}
+
+int memcmp(const void *a, const void *b, size_t n) {
+#ifdef CONFIG_RVV
+    if (n >= MEM_VEC_MIN) {
+        size_t i = vec_mismatch(a, b, n);
+        if (i == n) {
+            return 0;
+        }
+        return (int)((const uint8_t *)a)[i] - (int)((const uint8_t *)b)[i];
+    }
+#endif
+    return memcmp_scalar(a, b, n);
+}
+
+RAMFUNC int mem_is_blank(const void *p, size_t n) {
+#ifdef CONFIG_RVV
+    if (n >= MEM_VEC_MIN) {
+        return vec_is_blank(p, n);
+    }
+#endif
+    return mem_is_blank_scalar(p, n);
+}
@@ -0,0 +1,70 @@
+#include "boot.h"
+
+/*
+ * RISC-V Semihosting Image Source (development boots)
+ *
+ * Reads the application straight from the host filesystem, e.g. QEMU with
+ *   -semihosting-config enable=on,target=native
+ * so edit-build-boot cycles need no UART upload. Without a semihosting host
+ * every request fails cleanly (see src/semihost.S) and boot continues.
+ */
+
+#define SYS_OPEN    0x01
+#define SYS_CLOSE   0x02
+#define SYS_READ    0x06
+#define SYS_SEEK    0x0A
+#define SYS_FLEN    0x0C
+
+#define SYS_OPEN_MODE_RB    1   /* fopen() mode "rb" */
+
+long semihost_call(long op, void *arg);
+
+static long semihost_fd = -1;
+
+static int cstr_len(const char *s) {
+    int n = 0;
+    while (s[n]) {
+        n++;
+    }
+    return n;
+}
+
+uint32_t semihost_image_open(const char *path) {
+    long open_args[3] = { (long)(uintptr_t)path, SYS_OPEN_MODE_RB, cstr_len(path) };
+
+    semihost_fd = semihost_call(SYS_OPEN, open_args);
+    if (semihost_fd < 0) {
+        return 0;
+    }
+
+    long flen_args[1] = { semihost_fd };
+    long len = semihost_call(SYS_FLEN, flen_args);
+    if (len <= 0) {
+        semihost_image_close();
+        return 0;
+    }
+    return (uint32_t)len;
+}
+
+int semihost_image_read(uint32_t offset, void *buf, size_t len) {
+    if (semihost_fd < 0) {
+        return -1;
+    }
+
+    long seek_args[2] = { semihost_fd, (long)offset };
+    if (semihost_call(SYS_SEEK, seek_args) != 0) {
+        return -1;
+    }
+
+    /* SYS_READ returns the number of bytes NOT read */
+    long read_args[3] = { semihost_fd, (long)(uintptr_t)buf, (long)len };
+    return (semihost_call(SYS_READ, read_args) == 0) ? 0 : -1;
+}
+
+void semihost_image_close(void) {
+    if (semihost_fd >= 0) {
+        long close_args[1] = { semihost_fd };
+        semihost_call(SYS_CLOSE, close_args);
+        semihost_fd = -1;
+    }
+}
@@ -0,0 +1,185 @@
+#include "boot.h"
+
+/*
+ * SHA-256 (FIPS 180-4), streaming
+ *
+ * Two compression functions share one round structure:
+ * - portable C (rotates and shifts)
+ * - scalar crypto Zknh (sha256sum0/sum1/sig0/sig1), built when the
+ *   compiler targets it (-march=..._zknh, see ZKNH=1 in the Makefile)
+ * sha256_update() uses the fastest one available. Both run from RAM with
+ * it (RAMFUNC): image_feed_start() hashes a chunk while it programs.
+ */
+
+static const uint32_t sha256_k[64] RAMDATA = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotr(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+#if defined(__riscv_zknh)
+static inline uint32_t zk_sum0(uint32_t x) { uint32_t r; __asm__ ("sha256sum0 %0, %1" : "=r"(r) : "r"(x)); return r; }
+static inline uint32_t zk_sum1(uint32_t x) { uint32_t r; __asm__ ("sha256sum1 %0, %1" : "=r"(r) : "r"(x)); return r; }
+static inline uint32_t zk_sig0(uint32_t x) { uint32_t r; __asm__ ("sha256sig0 %0, %1" : "=r"(r) : "r"(x)); return r; }
+static inline uint32_t zk_sig1(uint32_t x) { uint32_t r; __asm__ ("sha256sig1 %0, %1" : "=r"(r) : "r"(x)); return r; }
+#endif
+
+/* @zk is a compile-time constant at each call site: no runtime dispatch */
+static inline __attribute__((always_inline))
+uint32_t big_sum0(uint32_t x, int zk) {
+#if defined(__riscv_zknh)
+    if (zk) return zk_sum0(x);
+#endif
+    (void)zk;
+    return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+}
+
+static inline __attribute__((always_inline))
+uint32_t big_sum1(uint32_t x, int zk) {
+#if defined(__riscv_zknh)
+    if (zk) return zk_sum1(x);
+#endif
+    (void)zk;
+    return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+}
+
+static inline __attribute__((always_inline))
+uint32_t small_sig0(uint32_t x, int zk) {
+#if defined(__riscv_zknh)
+    if (zk) return zk_sig0(x);
+#endif
+    (void)zk;
+    return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
+}
+
+static inline __attribute__((always_inline))
+uint32_t small_sig1(uint32_t x, int zk) {
+#if defined(__riscv_zknh)
+    if (zk) return zk_sig1(x);
+#endif
+    (void)zk;
+    return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
+}
+
+static inline __attribute__((always_inline))
+void sha256_rounds(uint32_t state[8], const uint8_t *block, int zk) {
+    uint32_t w[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t wi;
+        if (i < 16) {
+            wi = load_be32(block + 4 * i);
+        } else {
+            /* Rolling 16-word message schedule */
+            wi = small_sig1(w[(i - 2) & 15], zk) + w[(i - 7) & 15] +
+                 small_sig0(w[(i - 15) & 15], zk) + w[i & 15];
+        }
+        w[i & 15] = wi;
+
+        uint32_t t1 = h + big_sum1(e, zk) + ((e & f) ^ (~e & g)) + sha256_k[i] + wi;
+        uint32_t t2 = big_sum0(a, zk) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+RAMFUNC void sha256_compress_c(uint32_t state[8], const uint8_t *block) {
+    sha256_rounds(state, block, 0);
+}
+
+#if defined(__riscv_zknh)
+RAMFUNC void sha256_compress_zknh(uint32_t state[8], const uint8_t *block) {
+    sha256_rounds(state, block, 1);
+}
+#define sha256_compress sha256_compress_zknh
+#else
+#define sha256_compress sha256_compress_c
+#endif
+
+void sha256_init(sha256_ctx_t *ctx) {
+    static const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = iv[i];
+    }
+    ctx->total = 0;
+    ctx->buf_len = 0;
+}
+
+RAMFUNC void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len) {
+    ctx->total += len;
+
+    /* Top up a partial block first */
+    if (ctx->buf_len) {
+        while (len && ctx->buf_len < SHA256_BLOCK_SIZE) {
+            ctx->buf[ctx->buf_len++] = *data++;
+            len--;
+        }
+        if (ctx->buf_len < SHA256_BLOCK_SIZE) {
+            return;
+        }
+        sha256_compress(ctx->state, ctx->buf);
+        ctx->buf_len = 0;
+    }
+
+    /* Whole blocks straight from the caller's buffer */
+    while (len >= SHA256_BLOCK_SIZE) {
+        sha256_compress(ctx->state, data);
+        data += SHA256_BLOCK_SIZE;
+        len -= SHA256_BLOCK_SIZE;
+    }
+
+    while (len--) {
+        ctx->buf[ctx->buf_len++] = *data++;
+    }
+}
+
+void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    /* Split the bit count: no 64-bit variable shifts (no libgcc) */
+    uint64_t bits = ctx->total << 3;
+    uint32_t bits_hi = (uint32_t)(bits >> 32);
+    uint32_t bits_lo = (uint32_t)bits;
+
+    /* 0x80 terminator, zero pad, 64-bit big-endian bit length */
+    ctx->buf[ctx->buf_len++] = 0x80;
+    if (ctx->buf_len > SHA256_BLOCK_SIZE - 8) {
+        while (ctx->buf_len < SHA256_BLOCK_SIZE) {
+            ctx->buf[ctx->buf_len++] = 0;
+        }
+        sha256_compress(ctx->state, ctx->buf);
+        ctx->buf_len = 0;
+    }
+    while (ctx->buf_len < SHA256_BLOCK_SIZE - 8) {
+        ctx->buf[ctx->buf_len++] = 0;
+    }
+    for (int i = 3; i >= 0; i--) {
+        ctx->buf[ctx->buf_len++] = (uint8_t)(bits_hi >> (8 * i));
+    }
+    for (int i = 3; i >= 0; i--) {
+        ctx->buf[ctx->buf_len++] = (uint8_t)(bits_lo >> (8 * i));
+    }
+    sha256_compress(ctx->state, ctx->buf);
+
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
@@ -0,0 +1,35 @@
+#include "boot.h"
+
+/*
+ * Persistent Boot State
+ *
+ * A single CRC-protected record in the STATE sector (outside both the
+ * bootloader image and the APP partition, so updates never touch it).
+ * Writers rewrite the whole sector; callers only store when the contents
+ * actually change, which keeps flash wear to one erase per new image.
+ */
+
+static uint32_t state_crc(const boot_state_t *st) {
+    return crc32((const uint8_t *)st, offsetof(boot_state_t, crc32));
+}
+
+int state_load(boot_state_t *st) {
+    const boot_state_t *rec = (const boot_state_t *)STATE_BASE;
+
+    if (rec->magic == STATE_MAGIC && rec->crc32 == state_crc(rec)) {
+        memcpy(st, rec, sizeof(*st));
+        return 0;
+    }
+    memset(st, 0, sizeof(*st));
+    return -1;
+}
+
+int state_store(boot_state_t *st) {
+    st->magic = STATE_MAGIC;
+    st->crc32 = state_crc(st);
+
+    if (flash_erase(STATE_BASE, STATE_SIZE) != 0) {
+        return -1;
+    }
+    return flash_write(STATE_BASE, st, sizeof(*st));
+}
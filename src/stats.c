@@ -0,0 +1,33 @@
+#include "boot.h"
+
+/*
+ * Runtime Counters
+ *
+ * Cheap counters kept by the drivers while the bootloader runs, reported
+ * as BL_EVT:STAT_<NAME>:<value> so the host side can track them per run.
+ */
+
+boot_stats_t boot_stats;
+
+/* Written over the whole main stack by start.S before main() runs */
+#define STACK_PAINT 0x5AA5F00Du
+
+extern uint32_t _stack_bottom[];
+extern uint32_t _stack_top[];
+
+uint32_t stats_stack_peak(void) {
+    /* The stack grows down: the lowest overwritten word marks the peak */
+    const uint32_t *p = _stack_bottom;
+    while (p < _stack_top && *p == STACK_PAINT) {
+        p++;
+    }
+    return (uint32_t)((uintptr_t)_stack_top - (uintptr_t)p);
+}
+
+void stats_report(void) {
+    emit_bl_evt_u32("STAT_UART_OVERRUN", platform_uart_overruns());
+    emit_bl_evt_u32("STAT_UART_RX_PEAK", boot_stats.uart_rx_peak);
+    emit_bl_evt_u32("STAT_UART_FLOW_STOP", boot_stats.uart_flow_stops);
+    emit_bl_evt_u32("STAT_ARENA_PEAK", boot_stats.arena_peak);
+    emit_bl_evt_u32("STAT_STACK_PEAK", stats_stack_peak());
+}
@@ -0,0 +1,84 @@
+#include "boot.h"
+
+/*
+ * Update Protocol Transports
+ *
+ * Responsibilities:
+ * - Wrap each HAL byte channel in a common transport_t
+ * - Provide string helpers so protocol code is channel-agnostic
+ *
+ * The 16550 moves one byte per register access; the auxiliary console
+ * (virtio-console on QEMU) moves whole buffers per call.
+ */
+
+/* ---- 16550 UART --------------------------------------------------------- */
+
+static RAMFUNC void uart_tp_read(uint8_t *buf, size_t len) {
+    /* Through the RX ring, so flow control sees every byte */
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)uart_getc();
+    }
+}
+
+static void uart_tp_write(const uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        platform_uart_putc((char)buf[i]);
+    }
+}
+
+const transport_t transport_uart = {
+    .name = "uart",
+    .rx_ready = uart_rx_ready,
+    .read = uart_tp_read,
+    .write = uart_tp_write,
+};
+
+/* ---- Auxiliary console -------------------------------------------------- */
+
+static const transport_t transport_console = {
+    .name = "console",
+    .rx_ready = platform_console_rx_ready,
+    .read = platform_console_read,
+    .write = platform_console_write,
+};
+
+const transport_t *transport_console_open(void) {
+    return (platform_console_init() == 0) ? &transport_console : NULL;
+}
+
+/* ---- Helpers ------------------------------------------------------------ */
+
+RAMFUNC char transport_getc(const transport_t *t) {
+    uint8_t c;
+    t->read(&c, 1);
+    return (char)c;
+}
+
+void transport_putc(const transport_t *t, char c) {
+    /* Same newline normalization as uart_putc() */
+    static const uint8_t crlf[2] = { '\r', '\n' };
+    if (c == '\n') {
+        t->write(crlf, 2);
+    } else {
+        t->write((const uint8_t *)&c, 1);
+    }
+}
+
+void transport_puts(const transport_t *t, const char *s) {
+    /* Send runs between newlines in one write, so buffer channels stay cheap */
+    static const uint8_t crlf[2] = { '\r', '\n' };
+    while (*s) {
+        size_t n = 0;
+        while (s[n] && s[n] != '\n') {
+            n++;
+        }
+        if (n) {
+            t->write((const uint8_t *)s, n);
+            s += n;
+        }
+        if (*s == '\n') {
+            t->write(crlf, 2);
+            s++;
+        }
+    }
+}
@@ -25,9 +25,56 @@ void uart_putc(char c) {
     platform_uart_putc(c);
 }
 
-char uart_getc(void) {
-    /* Blocking character read via platform-specific implementation */
-    return platform_uart_getc();
+/*
+ * RX ring with flow control
+ *
+ * The 16550 FIFO holds 16 bytes; anything polling the UART (including the
+ * flash wait loops of an update) moves them into this ring first. Above the
+ * high-water mark the sender is told to pause (XOFF and/or RTS deasserted,
+ * per board policy) and resumed below the low-water mark, so a host can
+ * stream at full speed while erases and page programs are in progress.
+ */
+static uint8_t rx_ring[UART_RX_RING_SIZE];
+static uint32_t rx_head;    /* Bytes pushed (free-running) */
+static uint32_t rx_tail;    /* Bytes popped (free-running) */
+static int rx_stopped;
+
+static RAMFUNC void uart_flow(int stop) {
+    rx_stopped = stop;
+#if PLATFORM_UART_XONXOFF
+    platform_uart_putc(stop ? UART_XOFF : UART_XON);
+#endif
+#if PLATFORM_UART_RTSCTS
+    platform_uart_set_rts(!stop);
+#endif
+    if (stop) {
+        boot_stats.uart_flow_stops++;
+    }
+}
+
+RAMFUNC int uart_rx_ready(void) {
+    while (rx_head - rx_tail < UART_RX_RING_SIZE && platform_uart_rx_ready()) {
+        rx_ring[rx_head++ % UART_RX_RING_SIZE] = (uint8_t)platform_uart_getc();
+    }
+
+    uint32_t fill = rx_head - rx_tail;
+    if (fill > boot_stats.uart_rx_peak) {
+        boot_stats.uart_rx_peak = fill;
+    }
+    if (!rx_stopped && fill >= UART_RX_HIGH_WATER) {
+        uart_flow(1);
+    }
+    return fill != 0;
+}
+
+RAMFUNC char uart_getc(void) {
+    while (!uart_rx_ready()) {
+    }
+    char c = (char)rx_ring[rx_tail++ % UART_RX_RING_SIZE];
+    if (rx_stopped && rx_head - rx_tail <= UART_RX_LOW_WATER) {
+        uart_flow(0);
+    }
+    return c;
 }
 
 void uart_puts(const char *s) {
@@ -36,3 +83,49 @@ void uart_puts(const char *s) {
         uart_putc(*s++);
     }
 }
+
+void emit_bl_evt(const char *token) {
+    uart_puts("BL_EVT:");
+    uart_puts(token);
+    uart_puts("\n");
+}
+
+void emit_bl_evt_u32(const char *token, uint32_t value) {
+    /* BL_EVT:<TOKEN>:<VALUE> form for tokens carrying a number */
+    uart_puts("BL_EVT:");
+    uart_puts(token);
+    uart_putc(':');
+    uart_put_dec(value);
+    uart_puts("\n");
+}
+
+static void put_dec(void (*put)(char), uint32_t value) {
+    /* Render digits backwards into a small buffer, then send in order */
+    char buf[10];
+    int i = 0;
+    do {
+        buf[i++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value);
+    while (i > 0) {
+        put(buf[--i]);
+    }
+}
+
+void uart_put_dec(uint32_t value) {
+    put_dec(uart_putc, value);
+}
+
+/* One character out, then whatever arrived meanwhile into the RX ring */
+static void uart_putc_rx(char c) {
+    uart_putc(c);
+    uart_rx_ready();
+}
+
+void emit_bl_evt_progress(uint32_t bytes) {
+    for (const char *s = "BL_EVT:UPDATE_PROGRESS:"; *s; s++) {
+        uart_putc_rx(*s);
+    }
+    put_dec(uart_putc_rx, bytes);
+    uart_putc_rx('\n');
+}
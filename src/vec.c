@@ -0,0 +1,98 @@
+#include "boot.h"
+
+/*
+ * RISC-V Vector Bulk Memory Kernels (RVV=1 builds only)
+ *
+ * Strip-mined vsetvli loops over bytes (SEW=8, LMUL=8): every pass handles
+ * as many bytes as the hardware grants, so the code is vector-length
+ * agnostic and needs no tail handling. Integer-only (Zve32x), so no FPU
+ * state is involved; start.S enables mstatus.VS.
+ *
+ * These back memcpy/memset/memcmp/mem_is_blank for large buffers
+ * (src/mem.c); the scalar word-wide versions remain the fallback. Those
+ * behind RAMFUNC callers are RAMFUNC as well.
+ */
+
+#ifdef CONFIG_RVV
+
+#define VEC_CLOBBERS "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15", \
+                     "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23"
+
+RAMFUNC void vec_fill(void *dest, uint8_t value, size_t n) {
+    uint8_t *d = (uint8_t *)dest;
+    while (n) {
+        size_t vl;
+        __asm__ volatile ("vsetvli %0, %1, e8, m8, ta, ma\n\t"
+                          "vmv.v.x v8, %2\n\t"
+                          "vse8.v v8, (%3)"
+                          : "=&r"(vl)
+                          : "r"(n), "r"(value), "r"(d)
+                          : "memory", VEC_CLOBBERS);
+        d += vl;
+        n -= vl;
+    }
+}
+
+RAMFUNC void vec_copy(void *dest, const void *src, size_t n) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+    while (n) {
+        size_t vl;
+        __asm__ volatile ("vsetvli %0, %1, e8, m8, ta, ma\n\t"
+                          "vle8.v v8, (%2)\n\t"
+                          "vse8.v v8, (%3)"
+                          : "=&r"(vl)
+                          : "r"(n), "r"(s), "r"(d)
+                          : "memory", VEC_CLOBBERS);
+        s += vl;
+        d += vl;
+        n -= vl;
+    }
+}
+
+size_t vec_mismatch(const void *a, const void *b, size_t n) {
+    const uint8_t *pa = (const uint8_t *)a;
+    const uint8_t *pb = (const uint8_t *)b;
+    size_t done = 0;
+    while (done < n) {
+        size_t vl;
+        long first;
+        __asm__ volatile ("vsetvli %0, %2, e8, m8, ta, ma\n\t"
+                          "vle8.v v8, (%3)\n\t"
+                          "vle8.v v16, (%4)\n\t"
+                          "vmsne.vv v0, v8, v16\n\t"
+                          "vfirst.m %1, v0"
+                          : "=&r"(vl), "=&r"(first)
+                          : "r"(n - done), "r"(pa + done), "r"(pb + done)
+                          : "memory", "v0", VEC_CLOBBERS);
+        if (first >= 0) {
+            return done + (size_t)first;
+        }
+        done += vl;
+    }
+    return n;
+}
+
+RAMFUNC int vec_is_blank(const void *p, size_t n) {
+    const uint8_t *s = (const uint8_t *)p;
+    while (n) {
+        size_t vl;
+        long first;
+        /* vmsne.vi with -1: immediate is sign-extended to SEW, i.e. 0xFF */
+        __asm__ volatile ("vsetvli %0, %2, e8, m8, ta, ma\n\t"
+                          "vle8.v v8, (%3)\n\t"
+                          "vmsne.vi v0, v8, -1\n\t"
+                          "vfirst.m %1, v0"
+                          : "=&r"(vl), "=&r"(first)
+                          : "r"(n), "r"(s)
+                          : "memory", "v0", VEC_CLOBBERS);
+        if (first >= 0) {
+            return 0;
+        }
+        s += vl;
+        n -= vl;
+    }
+    return 1;
+}
+
+#endif /* CONFIG_RVV */
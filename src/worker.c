@@ -0,0 +1,165 @@
+#include "boot.h"
+
+/*
+ * Update Worker Hart
+ *
+ * On multi-hart parts the update path is split in two: hart 0 owns the
+ * transport and only fills chunk buffers, while PLATFORM_WORKER_HART
+ * decrypts, checksums and programs them, so flash time overlaps the link.
+ * The harts meet in a lock-free single-producer/single-consumer ring:
+ *
+ *  - head is written only by the producer (hart 0), tail only by the worker
+ *  - indices run freely (mod 2^32); slot = index % WORKER_RING_SLOTS
+ *  - fences order chunk data against the index that publishes it, so no
+ *    A-extension atomics are needed (RV32IM has none)
+ *
+ * Without a worker hart (single-hart parts, QEMU -smp 1) worker_start()
+ * times out and uart_update() keeps doing everything on hart 0.
+ *
+ * At handoff the worker is normally parked; worker_handoff() instead gives
+ * it one last job that runs alongside the app (deferred image checks).
+ */
+
+#define WORKER_OFF      0
+#define WORKER_READY    1
+#define WORKER_STOP     2
+#define WORKER_HANDOFF  3
+
+typedef struct {
+    volatile uint32_t head;     /* Chunks published by the producer */
+    volatile uint32_t tail;     /* Chunks consumed by the worker */
+    worker_chunk_t slot[WORKER_RING_SLOTS];
+} worker_ring_t;
+
+static worker_ring_t ring;
+static volatile int worker_state;
+static int worker_up;           /* Hart 0 view: worker came up in time */
+
+/* Current job; published to the worker by the first chunk's head update */
+static image_writer_t *job_writer;
+static aes_ctr_t *job_ctr;
+static volatile int job_err;
+
+/* Last job, run after the app has been started (worker_handoff()) */
+static void (*handoff_fn)(void *);
+static void *handoff_arg;
+
+#define fence(pred_succ)    __asm__ volatile ("fence " pred_succ ::: "memory")
+
+void worker_main(void) {
+    /* .bss is not ready before the start signal: touch no globals here */
+    platform_hart_wait_start();
+    /* RAMFUNC code was copied by hart 0: sync this hart's fetch with it */
+    __asm__ volatile ("fence.i" ::: "memory");
+
+    worker_state = WORKER_READY;
+    while (1) {
+        uint32_t tail = ring.tail;
+        if (tail == ring.head) {
+            int state = worker_state;
+            if (state == WORKER_STOP) {
+                break;
+            }
+            if (state == WORKER_HANDOFF) {
+                /* State before the job it publishes */
+                fence("r, r");
+                handoff_fn(handoff_arg);
+                break;
+            }
+            continue;
+        }
+        /* Read head before the chunk it publishes */
+        fence("r, r");
+
+        worker_chunk_t *c = &ring.slot[tail % WORKER_RING_SLOTS];
+        if (job_err == IMAGE_OK) {
+            if (job_ctr) {
+                aes_ctr_xor(job_ctr, c->data, c->len);
+            }
+            job_err = image_feed(job_writer, c->data, c->len);
+        }
+
+        /* Done with the slot (and the writer) before handing it back */
+        fence("rw, w");
+        ring.tail = tail + 1;
+    }
+
+    /* Returns to start.S, which parks the hart without touching RAM */
+    fence("rw, w");
+    worker_state = WORKER_OFF;
+}
+
+int worker_start(void) {
+    platform_hart_start(PLATFORM_WORKER_HART);
+
+    uint32_t start = cycle_count();
+    while (worker_state != WORKER_READY) {
+        if (cycle_count() - start > PLATFORM_WORKER_START_TIMEOUT) {
+            return -1;
+        }
+    }
+    worker_up = 1;
+    emit_bl_evt_u32("WORKER_HART", PLATFORM_WORKER_HART);
+    return 0;
+}
+
+int worker_online(void) {
+    return worker_up;
+}
+
+void worker_begin(image_writer_t *w, aes_ctr_t *ctr) {
+    /* The ring is empty here; the fence in worker_chunk_put() publishes these */
+    job_writer = w;
+    job_ctr = ctr;
+    job_err = IMAGE_OK;
+}
+
+worker_chunk_t *worker_chunk_get(void) {
+    uint32_t head = ring.head;
+    if (head - ring.tail >= WORKER_RING_SLOTS) {
+        /* Ring full: the worker is still programming */
+        return NULL;
+    }
+    /* The worker has finished reading the slot before we overwrite it */
+    fence("r, rw");
+    return &ring.slot[head % WORKER_RING_SLOTS];
+}
+
+void worker_chunk_put(worker_chunk_t *c) {
+    (void)c;
+    /* Chunk (and job) contents before the index that publishes them */
+    fence("w, w");
+    ring.head = ring.head + 1;
+}
+
+int worker_drain(void) {
+    while (ring.tail != ring.head) {
+    }
+    /* Everything the worker wrote (flash, writer state) is visible now */
+    fence("r, rw");
+    return job_err;
+}
+
+int worker_handoff(void (*fn)(void *), void *arg) {
+    if (!worker_up || worker_state != WORKER_READY) {
+        return -1;
+    }
+    handoff_fn = fn;
+    handoff_arg = arg;
+    /* Job (and everything @arg points at) before the state that publishes it */
+    fence("w, w");
+    worker_state = WORKER_HANDOFF;
+    worker_up = 0;
+    return 0;
+}
+
+void worker_stop(void) {
+    /* Also catches a worker that came up after worker_start() gave up */
+    if (worker_state != WORKER_READY) {
+        return;
+    }
+    worker_state = WORKER_STOP;
+    while (worker_state != WORKER_OFF) {
+    }
+    worker_up = 0;
+}
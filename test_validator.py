@@ -4,6 +4,7 @@ import argparse
 import os
 import queue
 import shutil
+import socket
 import subprocess
 import sys
 import threading
@@ -44,7 +45,29 @@ _uart_last_was_newline = False
 
 # Demo pacing globals
 _demo_step_delay = 0.0
-_demo_byte_delay = 0.0003
+_demo_byte_delay = 0.0
+_qemu_system = "qemu-system-riscv32"  # qemu-system-riscv64 for ARCH=rv64 builds
+_qemu_smp = 1  # 2 = update worker on hart 1
+
+# Multi-MB runs (--image-mb): payload size and the measured update times
+_image_size = None
+_update_times = {}
+
+# APP partition of the default qemu_virt layout (boards/qemu_virt/board.h)
+APP_BASE = 0x80010000
+
+# QEMU monitor (QMP) for tests that reset the machine
+QMP_PORT = 4444
+
+# Upload even when INFO reports the same image already installed
+_force_upload = False
+
+# XON/XOFF flow control from the bootloader (RX ring above high-water mark);
+# only boards built with PLATFORM_UART_XONXOFF 1 send these
+XON, XOFF = b'\x11', b'\x13'
+UPLOAD_BLOCK = 64
+_tx_allowed = threading.Event()
+_tx_allowed.set()
 
 
 def progress(curr, total, byte_delay=0.0003):
@@ -152,7 +175,7 @@ def cleanup_uart_mirror():
 
 def find_qemu():
     """Find QEMU executable"""
-    exe = "qemu-system-riscv32" + (".exe" if sys.platform.startswith('win') else "")
+    exe = _qemu_system + (".exe" if sys.platform.startswith('win') else "")
     qemu = shutil.which(exe)
     if qemu:
         return qemu
@@ -167,7 +190,7 @@ def find_qemu():
 def kill_all_qemu():
     """Kill any running QEMU instances"""
     try:
-        cmd = ['taskkill', '/F', '/IM', 'qemu-system-riscv32.exe'] if sys.platform.startswith('win') else ['pkill', '-9', 'qemu-system-riscv32']
+        cmd = ['taskkill', '/F', '/IM', f'{_qemu_system}.exe'] if sys.platform.startswith('win') else ['pkill', '-9', _qemu_system]
         subprocess.run(cmd, capture_output=True)
     except:
         pass
@@ -180,6 +203,12 @@ def bg_reader(proc, q):
             byte = proc.stdout.read(1)
             if not byte:
                 break
+            if byte == XOFF:
+                _tx_allowed.clear()
+                continue
+            if byte == XON:
+                _tx_allowed.set()
+                continue
             _mirror_uart_byte(byte)
             q.put(byte)
     except Exception:
@@ -278,6 +307,31 @@ def send(proc, data):
     return True
 
 
+def query_info(proc):
+    """Send INFO ('i' at BOOT?); returns (fields dict or None on timeout, raw output).
+
+    Reply: INFO magic=0x5256424C size=<n> crc32=0x<hex> version=<n> valid=<0|1> err=<reason>
+    Numeric fields are returned as ints, the rest (err) as strings.
+    """
+    send(proc, 'i')
+    success, resp = wait_for(proc, "BL_EVT:APP_INFO", timeout=5 + _image_size_slack())
+    if not success or "INFO " not in resp:
+        return None, resp
+    line = resp[resp.index("INFO "):].splitlines()[0]
+    fields = {}
+    for key, value in (field.split("=", 1) for field in line.split()[1:] if "=" in field):
+        try:
+            fields[key] = int(value, 0)
+        except ValueError:
+            fields[key] = value
+    return fields, resp
+
+
+def _image_size_slack():
+    """Extra seconds for steps that scale with the image (multi-MB runs)"""
+    return (_image_size or 0) / (256 * 1024)
+
+
 def maybe_pause():
     """Optional pacing delay for demo narration."""
     if _demo_step_delay > 0:
@@ -297,10 +351,11 @@ def try_build_test_app():
         return False
 
 
-def make_firmware(size=None):
+def make_firmware(size=None, pad_to=None):
     """Generate test firmware with CRC
     
     If test_app.bin exists, load it; otherwise generate dummy firmware.
+    With pad_to, the app is zero-padded to that many bytes (multi-MB runs).
     """
     import os as os_module
     
@@ -317,24 +372,226 @@ def make_firmware(size=None):
         if size is None:
             size = FIRMWARE_SIZE
         app = (bytes(range(256)) * (size // 256 + 1))[:size]
+    if pad_to and len(app) < pad_to:
+        app += bytes(pad_to - len(app))
     
     return app, crc32(app) & 0xFFFFFFFF
 
 
-def test():
+def qmp_command(command):
+    """Run one QMP command on the monitor at QMP_PORT"""
+    with socket.create_connection(("localhost", QMP_PORT), timeout=5) as s:
+        s.recv(4096)  # Greeting
+        for cmd in ("qmp_capabilities", command):
+            s.sendall(f'{{"execute": "{cmd}"}}\n'.encode())
+            s.recv(4096)
+
+
+def test_fw_cfg():
+    """Provision the app through QEMU fw_cfg (no UART transfer) and boot it"""
+    kill_all_qemu()
+
+    print(f"\n{C.BOLD}RISC-V Bootloader fw_cfg Provisioning Test{C.END}\n")
+
+    proc = None
+    image_path = "fw_cfg_app.img"
+    try:
+        step(1, 5, "Packing test application")
+        firmware, fw_crc = make_firmware()
+        sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "scripts"))
+        from mkimage import pack
+        from ed25519 import load_key
+        with open(image_path, "wb") as f:
+            f.write(pack(firmware, key=load_key(os.path.join("keys", "dev_ed25519.key"))))
+        ok(f"{image_path}: {len(firmware)} bytes, crc32=0x{fw_crc:08X}, signed (dev key)")
+
+        step(2, 5, "Starting QEMU with fw_cfg image")
+        qemu_exe = find_qemu()
+        if not qemu_exe:
+            fail("QEMU not found. Install QEMU or add to PATH.")
+            return False
+
+        cmd = [qemu_exe, "-M", "virt", "-smp", str(_qemu_smp), "-display", "none", "-serial", "stdio",
+               "-bios", "none", "-kernel", "bootloader.elf",
+               "-fw_cfg", f"name=opt/rvbl/app,file={image_path}",
+               "-qmp", f"tcp:localhost:{QMP_PORT},server=on,wait=off"]
+        start = time.time()
+        proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, bufsize=0)
+        init_reader(proc)
+        ok("QEMU running")
+
+        step(3, 5, "Waiting for provisioning")
+        success, resp = wait_for(proc, "BL_EVT:APP_CRC_OK", timeout=5)
+        if not success:
+            fail(f"Image not installed (got: {repr(resp[-120:])})")
+            return False
+        ok(f"Image installed in {time.time() - start:.2f} s (including QEMU start)")
+
+        success, resp = wait_for(proc, "BOOT?", timeout=3)
+        if not success:
+            fail("No BOOT? prompt after provisioning")
+            return False
+
+        step(4, 5, "Booting provisioned application")
+        maybe_pause()
+        # INFO checks the image quietly (signature included) and must match
+        # it, so a host would skip re-provisioning this unit
+        info, resp = query_info(proc)
+        if info is None:
+            fail(f"No INFO reply (got: {repr(resp[-120:])})")
+            return False
+        if "BL_EVT:SIG_VERIFY" in resp or "Error:" in resp:
+            fail(f"INFO printed more than its reply (got: {repr(resp[-120:])})")
+            return False
+        if (info.get("valid") != 1 or info.get("err") != "none" or
+                info.get("size") != len(firmware) or info.get("crc32") != fw_crc):
+            fail(f"INFO does not match the provisioned image: {info}")
+            return False
+        ok("INFO matches the provisioned image (size, crc32, valid, err=none)")
+        send(proc, "\n")
+        success, resp = wait_for(proc, "BL_EVT:SIG_VERIFY_COLD", timeout=5)
+        if not success:
+            fail(f"Signature not verified (got: {repr(resp[-120:])})")
+            return False
+        success, resp = wait_for(proc, "APP_BOOT", timeout=5)
+        if not success:
+            fail(f"Application output not detected (got: {repr(resp[:120])})")
+            return False
+        ok("Signature verified, application boot banner detected")
+
+        step(5, 5, "Resetting with the same fw_cfg image")
+        qmp_command("system_reset")
+        success, resp = wait_for(proc, "BOOT?", timeout=5)
+        if not success:
+            fail(f"No BOOT? prompt after reset (got: {repr(resp[-120:])})")
+            return False
+        if "BL_EVT:HOST_IMAGE_CURRENT" not in resp or "APP_CRC_OK" in resp:
+            fail(f"Installed image was provisioned again (got: {repr(resp[-160:])})")
+            return False
+        ok("HOST_IMAGE_CURRENT: no erase/program for the image already installed")
+        send(proc, "\n")
+        success, resp = wait_for(proc, "APP_BOOT", timeout=5)
+        if not success or "BL_EVT:SIG_VERIFY_WARM" not in resp:
+            fail(f"Second boot did not reuse the verify result (got: {repr(resp[-160:])})")
+            return False
+        ok("SIG_VERIFY_WARM, application booted again")
+
+        proc.terminate()
+        print(f"\n{C.GREEN}{C.BOLD}✓ ALL TESTS PASSED{C.END}\n")
+        return True
+
+    except Exception as e:
+        fail(f"Error: {e}")
+        return False
+    finally:
+        if proc:
+            try:
+                proc.terminate()
+                proc.wait(timeout=1)
+            except:
+                proc.kill()
+        if os.path.exists(image_path):
+            os.remove(image_path)
+        cleanup_uart_mirror()
+
+
+def test_deferred_bad():
+    """A deferred image whose payload is corrupt boots once, then never again"""
+    kill_all_qemu()
+
+    print(f"\n{C.BOLD}RISC-V Bootloader Deferred-Verify Failure Test{C.END}\n")
+
+    proc = None
+    image_path = "deferred_bad.img"
+    try:
+        step(1, 4, "Packing a deferred image with a corrupt payload")
+        firmware, fw_crc = make_firmware(pad_to=64 * 1024)
+        sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "scripts"))
+        from mkimage import pack
+        image = bytearray(pack(firmware, deferred=True))
+        image[-1] ^= 0xFF   # Header checks pass, the payload pass does not
+        with open(image_path, "wb") as f:
+            f.write(image)
+        ok(f"{image_path}: {len(firmware)} bytes, header crc32=0x{fw_crc:08X}, last byte flipped")
+
+        step(2, 4, "Starting QEMU with the image preloaded in the APP partition")
+        qemu_exe = find_qemu()
+        if not qemu_exe:
+            fail("QEMU not found. Install QEMU or add to PATH.")
+            return False
+
+        # The loader device bypasses the install checks and restores the
+        # same bytes on every reset; the worker hart does the deferred check
+        cmd = [qemu_exe, "-M", "virt", "-smp", str(max(2, _qemu_smp)), "-display", "none",
+               "-serial", "stdio", "-bios", "none", "-kernel", "bootloader.elf",
+               "-device", f"loader,file={image_path},addr=0x{APP_BASE:X},force-raw=on"]
+        proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, bufsize=0)
+        init_reader(proc)
+        ok("QEMU running")
+
+        step(3, 4, "First boot: app starts before its check")
+        # Enter already queued at BOOT?, so no payload is checked up front
+        success, resp = wait_for(proc, "HW_READY", timeout=5)
+        if not success:
+            fail(f"Bootloader did not start (got: {repr(resp[-120:])})")
+            return False
+        send(proc, "\n")
+        success, resp = wait_for(proc, "BL_EVT:APP_VERIFY_DEFERRED", timeout=5)
+        if not success:
+            fail(f"Check not deferred (got: {repr(resp[-120:])})")
+            return False
+        ok("Check handed to the worker hart, app started")
+
+        step(4, 4, "Second boot: the failure survived the reset")
+        success, resp = wait_for(proc, "HW_READY", timeout=10)
+        if not success:
+            fail(f"Worker did not reset the machine (got: {repr(resp[-120:])})")
+            return False
+        send(proc, "\n")
+        success, resp = wait_for(proc, "BL_EVT:APP_CRC_FAIL", timeout=5)
+        if not success or "APP_VERIFY_DEFERRED" in resp or "APP_BOOT" in resp:
+            fail(f"Bad image was deferred again (got: {repr(resp[-160:])})")
+            return False
+        if "BL_EVT:APP_DEFERRED_BAD" not in resp:
+            fail(f"No APP_DEFERRED_BAD before recovery (got: {repr(resp[-160:])})")
+            return False
+        ok("APP_DEFERRED_BAD, full check failed, recovery")
+
+        proc.terminate()
+        print(f"\n{C.GREEN}{C.BOLD}✓ ALL TESTS PASSED{C.END}\n")
+        return True
+
+    except Exception as e:
+        fail(f"Error: {e}")
+        return False
+    finally:
+        if proc:
+            try:
+                proc.terminate()
+                proc.wait(timeout=1)
+            except:
+                proc.kill()
+        if os.path.exists(image_path):
+            os.remove(image_path)
+        cleanup_uart_mirror()
+
+
+def test(encrypt=False):
     kill_all_qemu()
 
     print(f"\n{C.BOLD}RISC-V Bootloader Validation Test{C.END}\n")
 
     proc = None
     try:
-        step(1, 7, "Starting QEMU bootloader")
+        step(1, 8, "Starting QEMU bootloader")
         qemu_exe = find_qemu()
         if not qemu_exe:
             fail("QEMU not found. Install QEMU or add to PATH.")
             return False
 
-        cmd = [qemu_exe, "-M", "virt", "-display", "none", "-serial", "stdio",
+        cmd = [qemu_exe, "-M", "virt", "-smp", str(_qemu_smp), "-display", "none", "-serial", "stdio",
                "-bios", "none", "-kernel", "bootloader.elf"]
 
         proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
@@ -343,14 +600,35 @@ def test():
         ok("QEMU running")
         init_reader(proc)
 
-        step(2, 7, "Waiting for bootloader")
+        step(2, 8, "Waiting for bootloader")
         success, resp = wait_for(proc, "BOOT?", timeout=3)
         if not success:
             fail(f"No BOOT? prompt (got: {repr(resp[:50])})")
             return False
         ok("Bootloader ready")
 
-        step(3, 7, "Entering update mode")
+        step(3, 8, "Querying installed image")
+        firmware, fw_crc = make_firmware(pad_to=_image_size)
+        info, _ = query_info(proc)
+        if info is None:
+            fail("No INFO reply")
+            return False
+        ok(f"Installed: size={info.get('size')} crc32=0x{info.get('crc32', 0):08X} "
+           f"valid={info.get('valid')} err={info.get('err')}")
+        if (not _force_upload and info.get("valid") == 1 and
+                info.get("size") == len(firmware) and info.get("crc32") == fw_crc):
+            ok("Image already installed: skipping the upload")
+            send(proc, "\n")
+            success, resp = wait_for(proc, "APP_BOOT", timeout=5 + _image_size_slack())
+            if not success:
+                fail(f"Application output not detected (got: {repr(resp[:120])})")
+                return False
+            ok("Application boot banner detected")
+            proc.terminate()
+            print(f"\n{C.GREEN}{C.BOLD}✓ ALL TESTS PASSED{C.END}\n")
+            return True
+
+        step(4, 8, "Entering update mode")
         maybe_pause()
         send(proc, 'u')
         time.sleep(0.03)
@@ -360,38 +638,65 @@ def test():
             return False
         ok("Update mode active")
 
-        step(4, 7, "Generating test application")
-        firmware, fw_crc = make_firmware()
-        ok("Test application ready")
-
-        step(5, 7, "Uploading firmware")
+        step(5, 8, "Generating test application")
+        # Erase, receive and boot-time checks grow with the image
+        slack = _image_size_slack()
         cmd = f"SEND {len(firmware)}\n"
+        if encrypt:
+            sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "scripts"))
+            from aes_ctr import ctr_xor, load_key
+            nonce = os.urandom(12)
+            firmware = ctr_xor(load_key(os.path.join("keys", "dev_aes256.key")), nonce, firmware)
+            cmd = f"SEND {len(firmware)} {nonce.hex()}\n"
+            ok("Test application ready (AES-256-CTR encrypted)")
+        else:
+            ok("Test application ready")
+
+        step(6, 8, "Uploading firmware")
         maybe_pause()
         for c in cmd:
             send(proc, c)
             time.sleep(0.001)
         time.sleep(0.03)
-        success, resp = wait_for(proc, "READY", timeout=5)
+        update_start = time.time()
+        success, resp = wait_for(proc, "READY", timeout=5 + slack)
         if not success:
             fail("Flash not ready")
             return False
         ok("Flash erased, ready for data")
 
-        for i, byte in enumerate(firmware):
-            if not send(proc, bytes([byte])):
+        # Full speed in blocks, pausing only while the bootloader sent XOFF
+        # (--demo-byte-delay paces byte by byte for narrated demos)
+        block = 1 if _demo_byte_delay > 0 else UPLOAD_BLOCK
+        for i in range(0, len(firmware), block):
+            if not _tx_allowed.wait(timeout=10):
+                fail(f"Flow control stuck in XOFF at byte {i}")
+                return False
+            if not send(proc, firmware[i:i + block]):
                 fail(f"Send failed at byte {i}")
                 return False
-            if i % 40 == 0:
-                progress(i, len(firmware))
-            time.sleep(_demo_byte_delay)
-        progress(len(firmware), len(firmware))
+            if i % 40 < block:
+                progress(i, len(firmware), _demo_byte_delay)
+            if _demo_byte_delay > 0:
+                time.sleep(_demo_byte_delay)
+        progress(len(firmware), len(firmware), _demo_byte_delay)
         ok(f"Uploaded {len(firmware)} bytes")
 
+        success, resp = wait_for(proc, "BL_EVT:STAT_UART_FLOW_STOP", timeout=20 + slack)
+        if not success:
+            fail("Receive statistics not reported")
+            return False
+        overruns = resp.split("BL_EVT:STAT_UART_OVERRUN:")[-1].split()[0] if "STAT_UART_OVERRUN:" in resp else "?"
+        if overruns != "0":
+            fail(f"UART overruns during upload: {overruns}")
+            return False
+        ok("No UART overruns")
+
         proc.stdin.write(b'\x00' * 32)
         proc.stdin.flush()
 
-        step(6, 7, "Validating CRC")
-        success, resp = wait_for(proc, "CRC?", timeout=20)
+        step(7, 8, "Validating CRC")
+        success, resp = wait_for(proc, "CRC?", timeout=20 + slack)
         if not success:
             fail("CRC check timeout")
             return False
@@ -408,15 +713,18 @@ def test():
             else:
                 fail("CRC validation failed")
             return False
-        ok("CRC validation passed")
+        elapsed = time.time() - update_start
+        _update_times[len(firmware)] = elapsed
+        ok(f"CRC validation passed ({len(firmware)} bytes updated in {elapsed:.2f} s, "
+           f"{len(firmware) / 1024 / elapsed:.0f} KB/s)")
 
-        step(7, 7, "Finalizing")
+        step(8, 8, "Finalizing")
         success, resp = wait_for(proc, "REBOOT", timeout=2)
         if success:
             ok("Reboot initiated")
 
         ok("Waiting for application output...")
-        success, resp = wait_for(proc, "APP_BOOT", timeout=5)
+        success, resp = wait_for(proc, "APP_BOOT", timeout=5 + slack)
         if not success:
             fail(f"Application output not detected (got: {repr(resp[:120])})")
             return False
@@ -466,8 +774,48 @@ def parse_args():
     parser.add_argument(
         "--demo-byte-delay",
         type=float,
-        default=0.0003,
-        help="Delay in seconds between firmware bytes during upload",
+        default=0.0,
+        help="Delay in seconds between firmware bytes during upload (default: full speed, XON/XOFF paced if enabled)",
+    )
+    parser.add_argument(
+        "--fw-cfg",
+        action="store_true",
+        help="Provision the app via QEMU fw_cfg (opt/rvbl/app) instead of a UART upload",
+    )
+    parser.add_argument(
+        "--deferred-bad",
+        action="store_true",
+        help="Boot a deferred image with a corrupt payload (worker hart) and "
+             "check the failure survives the reset",
+    )
+    parser.add_argument(
+        "--encrypt",
+        action="store_true",
+        help="Upload the app AES-256-CTR encrypted with the QEMU development key",
+    )
+    parser.add_argument(
+        "--rv64",
+        action="store_true",
+        help="Test an ARCH=rv64 build with qemu-system-riscv64",
+    )
+    parser.add_argument(
+        "--smp",
+        type=int,
+        default=1,
+        help="QEMU harts (2 = receive on hart 0, decrypt/CRC/flash on worker hart 1)",
+    )
+    parser.add_argument(
+        "--force-upload",
+        action="store_true",
+        help="Upload even if INFO shows the same image (size and CRC) installed",
+    )
+    parser.add_argument(
+        "--image-mb",
+        type=int,
+        nargs="+",
+        metavar="MB",
+        help="Pad the app to each size in MB and time the UART update "
+             "(needs a layout that fits, e.g. make APP_MB=32)",
     )
     return parser.parse_args()
 
@@ -477,8 +825,24 @@ if __name__ == '__main__':
         args = parse_args()
         _demo_step_delay = max(0.0, args.demo_step_delay)
         _demo_byte_delay = max(0.0, args.demo_byte_delay)
+        if args.rv64:
+            _qemu_system = "qemu-system-riscv64"
+        _qemu_smp = max(1, args.smp)
+        _force_upload = args.force_upload
         setup_uart_mirror(path=args.uart_mirror_file, live_only=args.uart_live_only)
-        success = test()
+        if args.image_mb:
+            success = True
+            for mb in args.image_mb:
+                _image_size = mb * 1024 * 1024
+                success = test(encrypt=args.encrypt) and success
+            print(f"{C.BOLD}Update time by image size{C.END}")
+            for size, elapsed in sorted(_update_times.items()):
+                print(f"  {size / (1024 * 1024):6.1f} MB  {elapsed:8.2f} s  "
+                      f"{size / 1024 / elapsed:8.0f} KB/s")
+        elif args.deferred_bad:
+            success = test_deferred_bad()
+        else:
+            success = test_fw_cfg() if args.fw_cfg else test(encrypt=args.encrypt)
         sys.exit(0 if success else 1)
     except KeyboardInterrupt:
         print("\n\nTest interrupted")